@@ -0,0 +1,484 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+// A small regex engine which parses the pattern at compile time into a type, so that the matcher
+// for it gets generated and inlined by the compiler. Matching is backtracking with the semantics
+// of PCRE (leftmost match, greedy quantifiers). Supported: literals, escapes (\d \D \w \W \s \S
+// and escaped metacharacters), ".", character classes with ranges and negation, groups with
+// "(...)" and "(?:...)", quantifiers "*", "+", "?", "{n}", "{n,}", "{n,m}", "|", "^" and "$".
+namespace compile_time_regex {
+
+template <std::size_t N>
+struct FixedString {
+    char chars[N];
+
+    constexpr FixedString(const char (&s)[N]) { std::copy_n(s, N, chars); }
+
+    constexpr std::size_t size() const { return N - 1; }
+    constexpr char operator[](const std::size_t i) const { return chars[i]; }
+    constexpr std::string_view view() const { return {chars, N - 1}; }
+};
+
+struct ByteSet {
+    std::array<std::uint64_t, 4> bits{};
+
+    constexpr void add(const unsigned char c) { bits[c / 64] |= std::uint64_t{1} << (c % 64); }
+    constexpr void add(const unsigned char first, const unsigned char last)
+    {
+        for (unsigned int c = first; c <= last; ++c)
+            add(static_cast<unsigned char>(c));
+    }
+
+    constexpr void add(const ByteSet& other)
+    {
+        for (std::size_t i = 0; i < bits.size(); ++i)
+            bits[i] |= other.bits[i];
+    }
+
+    constexpr void invert()
+    {
+        for (auto& b : bits)
+            b = ~b;
+    }
+
+    constexpr bool contains(const char c) const
+    {
+        const auto u = static_cast<unsigned char>(c);
+        return (bits[u / 64] >> (u % 64)) & 1;
+    }
+};
+
+inline constexpr std::size_t unbounded = static_cast<std::size_t>(-1);
+
+// Nodes of the parsed pattern.
+template <char C> struct Char {};
+template <ByteSet S> struct Bytes {};
+struct Begin {};
+struct End {};
+struct Empty {};
+template <typename Head, typename Tail> struct Sequence {};
+template <typename First, typename Second> struct Alternative {};
+template <std::size_t Min, std::size_t Max, typename Node> struct Repeat {};
+template <std::size_t Index, typename Node> struct Capture {};
+
+// Not constexpr, so calling it while parsing a pattern stops the compilation.
+inline void unsupported_pattern(const char*) {}
+
+constexpr bool is_alnum(const char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+
+constexpr ByteSet escape_set(const char c)
+{
+    ByteSet set;
+
+    switch (c) {
+        case 'd': case 'D': set.add('0', '9'); break;
+        case 'w': case 'W': set.add('0', '9'); set.add('a', 'z'); set.add('A', 'Z'); set.add('_'); break;
+        case 's': case 'S': set.add(' '); set.add('\t', '\r'); break;
+        case 'n': set.add('\n'); return set;
+        case 't': set.add('\t'); return set;
+        default: unsupported_pattern("unknown escape sequence");
+    }
+
+    if (c >= 'A' && c <= 'Z')
+        set.invert();
+
+    return set;
+}
+
+constexpr ByteSet any_but_newline()
+{
+    ByteSet set;
+    set.add('\n');
+    set.invert();
+    return set;
+}
+
+// Position after the character class starting with '[' at pos.
+template <std::size_t N>
+constexpr std::size_t class_end(const FixedString<N>& p, std::size_t pos)
+{
+    ++pos;
+
+    if (pos < p.size() && p[pos] == '^')
+        ++pos;
+
+    if (pos < p.size() && p[pos] == ']')
+        ++pos;
+
+    for (; pos < p.size() && p[pos] != ']'; ++pos)
+        if (p[pos] == '\\')
+            ++pos;
+
+    if (pos >= p.size())
+        unsupported_pattern("unterminated character class");
+
+    return pos + 1;
+}
+
+template <std::size_t N>
+constexpr ByteSet class_set(const FixedString<N>& p, std::size_t pos)
+{
+    ByteSet set;
+    const std::size_t end = class_end(p, pos) - 1;
+    const bool negated = p[pos + 1] == '^';
+
+    for (pos += negated ? 2 : 1; pos < end; ++pos) {
+        if (p[pos] == '\\' && is_alnum(p[pos + 1])) {
+            set.add(escape_set(p[++pos]));
+        } else {
+            if (p[pos] == '\\')
+                ++pos;
+
+            const auto first = static_cast<unsigned char>(p[pos]);
+
+            if (pos + 2 < end && p[pos + 1] == '-') {
+                pos += 2;
+
+                if (p[pos] == '\\')
+                    ++pos;
+
+                set.add(first, static_cast<unsigned char>(p[pos]));
+            } else {
+                set.add(first);
+            }
+        }
+    }
+
+    if (negated)
+        set.invert();
+
+    return set;
+}
+
+// Position after the group starting with '(' at pos.
+template <std::size_t N>
+constexpr std::size_t group_end(const FixedString<N>& p, std::size_t pos)
+{
+    for (int depth = 0; pos < p.size(); ++pos) {
+        if (p[pos] == '\\')
+            ++pos;
+        else if (p[pos] == '[')
+            pos = class_end(p, pos) - 1;
+        else if (p[pos] == '(')
+            ++depth;
+        else if (p[pos] == ')' && --depth == 0)
+            return pos + 1;
+    }
+
+    unsupported_pattern("unbalanced parentheses");
+    return pos;
+}
+
+template <std::size_t N>
+constexpr std::size_t atom_end(const FixedString<N>& p, const std::size_t pos)
+{
+    switch (p[pos]) {
+        case '(': return group_end(p, pos);
+        case '[': return class_end(p, pos);
+        case '\\': return pos + 2;
+        default: return pos + 1;
+    }
+}
+
+template <std::size_t N>
+constexpr bool is_capture(const FixedString<N>& p, const std::size_t pos)
+{
+    return pos < p.size() && p[pos] == '(' && p[pos + 1] != '?';
+}
+
+// Number of the capturing group starting at pos, or the number of capturing groups before pos.
+template <std::size_t N>
+constexpr std::size_t capture_index(const FixedString<N>& p, const std::size_t end)
+{
+    std::size_t count = 0;
+
+    for (std::size_t pos = 0; pos < end && pos < p.size(); ++pos) {
+        if (p[pos] == '\\')
+            ++pos;
+        else if (p[pos] == '[')
+            pos = class_end(p, pos) - 1;
+        else if (is_capture(p, pos))
+            ++count;
+    }
+
+    return is_capture(p, end) ? count + 1 : count;
+}
+
+struct Quantifier {
+    std::size_t min = 1;
+    std::size_t max = 1;
+    std::size_t end;
+};
+
+template <std::size_t N>
+constexpr Quantifier quantifier_at(const FixedString<N>& p, std::size_t pos)
+{
+    const auto read_number = [&] {
+        std::size_t n = 0;
+
+        for (; pos < p.size() && p[pos] >= '0' && p[pos] <= '9'; ++pos)
+            n = n * 10 + static_cast<std::size_t>(p[pos] - '0');
+
+        return n;
+    };
+
+    Quantifier q{1, 1, pos};
+
+    switch (pos < p.size() ? p[pos] : '\0') {
+        case '*': q = {0, unbounded, pos + 1}; break;
+        case '+': q = {1, unbounded, pos + 1}; break;
+        case '?': q = {0, 1, pos + 1}; break;
+        case '{':
+            ++pos;
+            q.min = q.max = read_number();
+
+            if (p[pos] == ',') {
+                ++pos;
+                q.max = p[pos] == '}' ? unbounded : read_number();
+            }
+
+            if (p[pos] != '}')
+                unsupported_pattern("malformed bounded repetition");
+
+            q.end = pos + 1;
+            break;
+        default: return q;
+    }
+
+    if (q.end < p.size() && (p[q.end] == '?' || p[q.end] == '+'))
+        unsupported_pattern("lazy and possessive quantifiers are not supported");
+
+    return q;
+}
+
+// Position of the first '|' between begin and end outside of groups and classes, or end.
+template <std::size_t N>
+constexpr std::size_t alternative_end(const FixedString<N>& p, std::size_t pos, const std::size_t end)
+{
+    for (; pos < end && p[pos] != '|'; pos = atom_end(p, pos)) {}
+
+    return pos;
+}
+
+template <FixedString P, std::size_t Begin, std::size_t End>
+constexpr auto parse_alternatives();
+
+template <FixedString P, std::size_t Pos>
+constexpr auto parse_atom()
+{
+    constexpr char c = P[Pos];
+
+    if constexpr (c == '(') {
+        constexpr std::size_t end = group_end(P, Pos);
+
+        if constexpr (is_capture(P, Pos)) {
+            return Capture<capture_index(P, Pos), decltype(parse_alternatives<P, Pos + 1, end - 1>())>{};
+        } else {
+            static_assert(P[Pos + 2] == ':', "only non-capturing groups are supported");
+            return decltype(parse_alternatives<P, Pos + 3, end - 1>()){};
+        }
+    } else if constexpr (c == '[') {
+        return Bytes<class_set(P, Pos)>{};
+    } else if constexpr (c == '\\') {
+        if constexpr (is_alnum(P[Pos + 1]))
+            return Bytes<escape_set(P[Pos + 1])>{};
+        else
+            return Char<P[Pos + 1]>{};
+    } else if constexpr (c == '.') {
+        return Bytes<any_but_newline()>{};
+    } else if constexpr (c == '^') {
+        return Begin{};
+    } else if constexpr (c == '$') {
+        return End{};
+    } else {
+        static_assert(c != ')' && c != '*' && c != '+' && c != '?' && c != '{', "unexpected metacharacter");
+        return Char<c>{};
+    }
+}
+
+template <FixedString P, std::size_t Begin, std::size_t End>
+constexpr auto parse_sequence()
+{
+    if constexpr (Begin == End) {
+        return Empty{};
+    } else {
+        using Atom = decltype(parse_atom<P, Begin>());
+        constexpr Quantifier q = quantifier_at(P, atom_end(P, Begin));
+        using Node = std::conditional_t<q.min == 1 && q.max == 1, Atom, Repeat<q.min, q.max, Atom>>;
+
+        if constexpr (q.end == End)
+            return Node{};
+        else
+            return Sequence<Node, decltype(parse_sequence<P, q.end, End>())>{};
+    }
+}
+
+template <FixedString P, std::size_t Begin, std::size_t End>
+constexpr auto parse_alternatives()
+{
+    constexpr std::size_t bar = alternative_end(P, Begin, End);
+
+    if constexpr (bar == End)
+        return parse_sequence<P, Begin, End>();
+    else
+        return Alternative<decltype(parse_sequence<P, Begin, bar>()), decltype(parse_alternatives<P, bar + 1, End>())>{};
+}
+
+template <std::size_t Count>
+struct Context {
+    static constexpr std::size_t unset = static_cast<std::size_t>(-1);
+
+    std::string_view subject;
+    std::array<std::pair<std::size_t, std::size_t>, Count> captures;
+};
+
+template <typename Node> struct SingleByte : std::false_type {};
+template <char C> struct SingleByte<Char<C>> : std::true_type {};
+template <ByteSet S> struct SingleByte<Bytes<S>> : std::true_type {};
+
+template <char C>
+constexpr bool matches_byte(Char<C>, const char c) { return c == C; }
+
+template <ByteSet S>
+constexpr bool matches_byte(Bytes<S>, const char c) { return S.contains(c); }
+
+// Every node calls the continuation with the position after its match and backtracks if that
+// fails, so the rest of the pattern gets inlined into the node which comes before it.
+
+template <typename Ctx, typename Cont>
+constexpr bool match(Empty, Ctx&, const std::size_t pos, Cont&& cont) { return cont(pos); }
+
+template <typename Ctx, typename Cont>
+constexpr bool match(Begin, Ctx&, const std::size_t pos, Cont&& cont) { return pos == 0 && cont(pos); }
+
+template <typename Ctx, typename Cont>
+constexpr bool match(End, Ctx& ctx, const std::size_t pos, Cont&& cont) { return pos == ctx.subject.size() && cont(pos); }
+
+template <char C, typename Ctx, typename Cont>
+constexpr bool match(Char<C> node, Ctx& ctx, const std::size_t pos, Cont&& cont)
+{
+    return pos < ctx.subject.size() && matches_byte(node, ctx.subject[pos]) && cont(pos + 1);
+}
+
+template <ByteSet S, typename Ctx, typename Cont>
+constexpr bool match(Bytes<S> node, Ctx& ctx, const std::size_t pos, Cont&& cont)
+{
+    return pos < ctx.subject.size() && matches_byte(node, ctx.subject[pos]) && cont(pos + 1);
+}
+
+template <typename Head, typename Tail, typename Ctx, typename Cont>
+constexpr bool match(Sequence<Head, Tail>, Ctx& ctx, const std::size_t pos, Cont&& cont)
+{
+    return match(Head{}, ctx, pos, [&](const std::size_t next) { return match(Tail{}, ctx, next, cont); });
+}
+
+template <typename First, typename Second, typename Ctx, typename Cont>
+constexpr bool match(Alternative<First, Second>, Ctx& ctx, const std::size_t pos, Cont&& cont)
+{
+    return match(First{}, ctx, pos, cont) || match(Second{}, ctx, pos, cont);
+}
+
+template <std::size_t Index, typename Node, typename Ctx, typename Cont>
+constexpr bool match(Capture<Index, Node>, Ctx& ctx, const std::size_t pos, Cont&& cont)
+{
+    return match(Node{}, ctx, pos, [&](const std::size_t next) {
+        const auto saved = ctx.captures[Index];
+        ctx.captures[Index] = {pos, next};
+
+        if (cont(next))
+            return true;
+
+        ctx.captures[Index] = saved;
+        return false;
+    });
+}
+
+template <std::size_t Min, std::size_t Max, typename Node, typename Ctx, typename Cont>
+constexpr bool match_repeat(Ctx& ctx, const std::size_t pos, const std::size_t count, Cont&& cont)
+{
+    if (count < Max && match(Node{}, ctx, pos, [&](const std::size_t next) { return (next != pos || count < Min) && match_repeat<Min, Max, Node>(ctx, next, count + 1, cont); }))
+        return true;
+
+    return count >= Min && cont(pos);
+}
+
+template <std::size_t Min, std::size_t Max, typename Node, typename Ctx, typename Cont>
+constexpr bool match(Repeat<Min, Max, Node>, Ctx& ctx, const std::size_t pos, Cont&& cont)
+{
+    if constexpr (SingleByte<Node>::value) {
+        // take as many bytes as possible, then give them back one by one
+        const std::size_t limit = Max == unbounded || ctx.subject.size() - pos < Max ? ctx.subject.size() : pos + Max;
+        std::size_t end = pos;
+
+        while (end < limit && matches_byte(Node{}, ctx.subject[end]))
+            ++end;
+
+        if (end - pos < Min)
+            return false;
+
+        for (;; --end) {
+            if (cont(end))
+                return true;
+
+            if (end - pos == Min)
+                return false;
+        }
+    } else {
+        return match_repeat<Min, Max, Node>(ctx, pos, 0, cont);
+    }
+}
+
+template <typename Node> struct FirstChar { static constexpr int value = -1; };
+template <char C> struct FirstChar<Char<C>> { static constexpr int value = static_cast<unsigned char>(C); };
+template <char C, typename Tail> struct FirstChar<Sequence<Char<C>, Tail>> : FirstChar<Char<C>> {};
+
+template <typename Node> struct Anchored : std::is_same<Node, Begin> {};
+template <typename Tail> struct Anchored<Sequence<Begin, Tail>> : std::true_type {};
+
+template <FixedString P>
+class Regex {
+public:
+    using Ast = decltype(parse_alternatives<P, 0, P.size()>());
+
+    static constexpr std::size_t capture_count = capture_index(P, P.size());
+
+    // The whole match followed by all capturing groups, groups which did not participate are empty.
+    using Captures = std::array<std::string_view, capture_count + 1>;
+
+    // Finds the leftmost match anywhere in the subject.
+    static constexpr bool search(const std::string_view subject, Captures& captures)
+    {
+        using Ctx = Context<capture_count + 1>;
+
+        Ctx ctx{subject, {}};
+        const std::size_t last_start = Anchored<Ast>::value ? 0 : subject.size();
+
+        for (std::size_t start = 0; start <= last_start; ++start) {
+            if constexpr (FirstChar<Ast>::value >= 0) {
+                start = subject.find(static_cast<char>(FirstChar<Ast>::value), start);
+
+                if (start == std::string_view::npos)
+                    return false;
+            }
+
+            ctx.captures.fill({Ctx::unset, Ctx::unset});
+
+            if (match(Ast{}, ctx, start, [&](const std::size_t end) { ctx.captures[0] = {start, end}; return true; })) {
+                for (std::size_t i = 0; i < captures.size(); ++i)
+                    captures[i] = ctx.captures[i].first == Ctx::unset ? std::string_view{} : subject.substr(ctx.captures[i].first, ctx.captures[i].second - ctx.captures[i].first);
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+}  // namespace compile_time_regex
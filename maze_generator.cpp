@@ -1,9 +1,38 @@
 #include <algorithm>
+#include <array>
 #include <benchmark/benchmark.h>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <list>
+#include <ostream>
 #include <random>
 #include <stack>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include "thread_pool.h"
+
 struct Node_v1 {
     bool visited = false;
     bool has_north_wall = true;
@@ -486,6 +515,10 @@ public:
     }
 
     const Directions* random_directions() { return all_possible_random_directions[random_dist_(random_generator_)]; }
+    int random_directions_index() { return random_dist_(random_generator_); }
+    const Directions* directions(const int index) const { return all_possible_random_directions[index]; }
+    Directions opposite_direction(const Directions dir) const { return opposite_direction_[static_cast<int>(dir)]; }
+    WallFlags wall_in_direction(const Directions dir) const { return wall_in_direction_[static_cast<int>(dir)]; }
 
     Node& node(const Coordinates coords) { return nodes_[static_cast<std::size_t>(coords.y * width_ + coords.x)]; };
     bool node_visited(const Coordinates coords) { return node(coords) & 0b10000; }
@@ -538,206 +571,846 @@ private:
         {Directions::West,  Directions::South, Directions::East,  Directions::North}};
 };
 
-struct StackNode_v1 {
-    Maze_v7::Coordinates coords;
-    std::vector<Maze_v7::Directions> check_directions;
-};
+class Maze_v10 {
+public:
+    using Node = unsigned char;
 
-struct StackNode_v2 {
-    Maze_v8::Coordinates coords;
-    const std::vector<Maze_v8::Directions>* check_directions;
-    int rnd_idx;
-};
+    enum class Directions { North = 0, East, South, West };
+    enum class WallFlags { North = 0b0001, East = 0b0010, South = 0b0100, West = 0b1000 };
 
-struct StackNode_v3 {
-    StackNode_v3(const Maze_v8::Coordinates c, const std::vector<Maze_v8::Directions>* d) : coords{c}, check_directions{d}, rnd_idx{0} {}
-    Maze_v8::Coordinates coords;
-    const std::vector<Maze_v8::Directions>* check_directions;
-    int rnd_idx;
-};
+    struct Coordinates { int x, y; };
 
-struct StackNode_v4 {
-    StackNode_v4(const Maze_v9::Coordinates c, const Maze_v9::Directions* d) : coords{c}, check_directions{d}, rnd_idx{0} {}
+    Maze_v10(const int width, const int height, const std::mt19937::result_type seed)
+        : width_{width},
+          height_{height},
+          nodes_(static_cast<std::size_t>(width * height), all_walls_),
+          random_generator_(seed),
+          random_dist_{0, 23} {}
 
-    const Maze_v9::Coordinates coords;
-    const Maze_v9::Directions* check_directions;
-    int rnd_idx;
-};
+    int width() const { return width_; }
+    int height() const { return height_; }
 
-void coord_in_direction_v1(const int x, const int y, const int dir, int* nx, int* ny)
-{
-    *nx = x;
-    *ny = y;
+    void reset() { std::fill(nodes_.begin(), nodes_.end(), all_walls_); }
 
-    switch (dir) {
-    case 0:
-        *nx = x;
-        *ny = y - 1;
-        break;
-    case 1:
-        *nx = x + 1;
-        *ny = y;
-        break;
-    case 2:
-        *nx = x;
-        *ny = y + 1;
-        break;
-    case 3:
-        *nx = x - 1;
-        *ny = y;
-        break;
+    void reset(const std::mt19937::result_type seed)
+    {
+        reset();
+        random_generator_.seed(seed);
+        random_dist_.reset();
     }
-}
 
-Coordinates_v2 coords_in_direction_v2(const Coordinates_v2 coords, const int dir)
-{
-    Coordinates_v2 new_coords{coords};
+    bool valid_coords(const Coordinates coords) const { return coords.x >= 0 && coords.y >= 0 && coords.x < width_ && coords.y < height_; }
 
-    switch (dir) {
-    case 0:
-        new_coords.y = coords.y - 1;
-        break;
-    case 1:
-        new_coords.x = coords.x + 1;
-        break;
-    case 2:
-        new_coords.y = coords.y + 1;
-        break;
-    case 3:
-        new_coords.x = coords.x - 1;
-        break;
+    Coordinates coords_in_direction(const Coordinates coords, const Directions dir) {
+        const Coordinates offset{direction_coords_offset_[static_cast<int>(dir)]};
+        return Coordinates{coords.x + offset.x, coords.y + offset.y};
     }
 
-    return new_coords;
-}
+    const Directions* random_directions() { return all_possible_random_directions[random_dist_(random_generator_)]; }
 
-Coordinates_v2 coords_in_direction_v3(const Coordinates_v2 coords, const Directions_v3 dir)
-{
-    Coordinates_v2 new_coords{coords};
+    Node& node(const Coordinates coords) { return nodes_[static_cast<std::size_t>(coords.y * width_ + coords.x)]; };
+    Node node(const Coordinates coords) const { return nodes_[static_cast<std::size_t>(coords.y * width_ + coords.x)]; };
+    bool node_visited(const Coordinates coords) { return node(coords) & 0b10000; }
+    void set_node_visited(const Coordinates coords) { node(coords) |= 0b10000; }
 
-    switch (dir) {
-    case Directions_v3::North:
-        new_coords.y = coords.y - 1;
-        break;
-    case Directions_v3::East:
-        new_coords.x = coords.x + 1;
-        break;
-    case Directions_v3::South:
-        new_coords.y = coords.y + 1;
-        break;
-    case Directions_v3::West:
-        new_coords.x = coords.x - 1;
-        break;
+    bool has_wall(const Coordinates coords, WallFlags wall) const { return node(coords) & static_cast<Node>(wall); }
+    void clear_walls(const Coordinates orig, const Coordinates dest, Directions dir) {
+        const WallFlags orig_wall = wall_in_direction_[static_cast<int>(dir)];
+        const WallFlags dest_wall = wall_in_direction_[static_cast<int>(opposite_direction_[static_cast<int>(dir)])];
+        node(orig) &= ~(static_cast<Node>(orig_wall));
+        node(dest) &= ~(static_cast<Node>(dest_wall));
     }
 
-    return new_coords;
-}
+    void clear_wall(const Coordinates coords, const WallFlags wall) { node(coords) &= ~(static_cast<Node>(wall)); }
 
-Node_v1* node_at_v1(Node_v1* maze, const int num_cols, const int x, const int y)
-{
-    return &maze[y * num_cols + x];
-}
+private:
+    static constexpr Node all_walls_ = static_cast<Node>(WallFlags::North) | static_cast<Node>(WallFlags::East) | static_cast<Node>(WallFlags::South) | static_cast<Node>(WallFlags::West);
 
-void visit_v1(Node_v1* maze, const int num_rows, const int num_cols, const int x, const int y)
-{
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::vector<int> directions{0, 1, 2, 3};
-    std::shuffle(directions.begin(), directions.end(), g);
+    const int width_;
+    const int height_;
+    std::vector<Node> nodes_;
 
-    Node_v1* current_node = node_at_v1(maze, num_cols, x, y);
+    std::mt19937 random_generator_;
+    std::uniform_int_distribution<> random_dist_;
 
-    current_node->visited = true;
+    static constexpr WallFlags wall_in_direction_[4] = { WallFlags::North, WallFlags::East, WallFlags::South, WallFlags::West };
+    static constexpr Directions opposite_direction_[4] = { Directions::South, Directions::West, Directions::North, Directions::East };
+    static constexpr Coordinates direction_coords_offset_[4] = { Coordinates{0, -1}, Coordinates{1, 0}, Coordinates{0, 1}, Coordinates{-1, 0} };
+    static constexpr Directions all_possible_random_directions[24][4] = {
+        {Directions::North, Directions::East,  Directions::South, Directions::West},
+        {Directions::North, Directions::East,  Directions::West,  Directions::South},
+        {Directions::North, Directions::South, Directions::East,  Directions::West},
+        {Directions::North, Directions::South, Directions::West,  Directions::East},
+        {Directions::North, Directions::West,  Directions::East,  Directions::South},
+        {Directions::North, Directions::West,  Directions::South, Directions::East},
+        {Directions::East,  Directions::North, Directions::South, Directions::West},
+        {Directions::East,  Directions::North, Directions::West,  Directions::South},
+        {Directions::East,  Directions::South, Directions::North, Directions::West},
+        {Directions::East,  Directions::South, Directions::West,  Directions::North},
+        {Directions::East,  Directions::West,  Directions::North, Directions::South},
+        {Directions::East,  Directions::West,  Directions::South, Directions::North},
+        {Directions::South, Directions::North, Directions::East,  Directions::West},
+        {Directions::South, Directions::North, Directions::West,  Directions::East},
+        {Directions::South, Directions::East,  Directions::North, Directions::West},
+        {Directions::South, Directions::East,  Directions::West,  Directions::North},
+        {Directions::South, Directions::West,  Directions::North, Directions::East},
+        {Directions::South, Directions::West,  Directions::East,  Directions::North},
+        {Directions::West,  Directions::North, Directions::East,  Directions::South},
+        {Directions::West,  Directions::North, Directions::South, Directions::East},
+        {Directions::West,  Directions::East,  Directions::North, Directions::South},
+        {Directions::West,  Directions::East,  Directions::South, Directions::North},
+        {Directions::West,  Directions::South, Directions::North, Directions::East},
+        {Directions::West,  Directions::South, Directions::East,  Directions::North}};
+};
 
-    for (auto dir : directions) {
-        int nx, ny;
-        coord_in_direction_v1(x, y, dir, &nx, &ny);
+struct RowMajorLayout {
+    RowMajorLayout(const int width, const int height) : width_{width}, height_{height} {}
 
-        if (nx >= 0 && ny >= 0 && nx < num_cols && ny < num_rows) {
-            Node_v1* next_node = node_at_v1(maze, num_cols, nx, ny);
+    std::size_t size() const { return static_cast<std::size_t>(width_ * height_); }
+    std::size_t index(const int x, const int y) const { return static_cast<std::size_t>(y * width_ + x); }
 
-            if (!next_node->visited) {
-                switch (dir) {
-                case 0:
-                    current_node->has_north_wall = false;
-                    next_node->has_south_wall = false;
-                    break;
-                case 1:
-                    current_node->has_east_wall = false;
-                    next_node->has_west_wall = false;
-                    break;
-                case 2:
-                    current_node->has_south_wall = false;
-                    next_node->has_north_wall = false;
-                    break;
-                case 3:
-                    current_node->has_west_wall = false;
-                    next_node->has_east_wall = false;
-                    break;
-                }
+private:
+    int width_;
+    int height_;
+};
 
-                visit_v1(maze, num_rows, num_cols, nx, ny);
-            }
+struct BlockedLayout {
+    BlockedLayout(const int width, const int height) : blocks_per_row_{(width + 7) / 8}, block_rows_{(height + 7) / 8} {}
 
-        }
-    }
-}
+    std::size_t size() const { return static_cast<std::size_t>(blocks_per_row_ * block_rows_) * 64; }
+    std::size_t index(const int x, const int y) const { return static_cast<std::size_t>((((y >> 3) * blocks_per_row_ + (x >> 3)) << 6) | ((y & 7) << 3) | (x & 7)); }
 
-void visit_v2(Maze_v2& maze, const Coordinates_v2 coords)
-{
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::vector<int> directions{0, 1, 2, 3};
-    std::shuffle(directions.begin(), directions.end(), g);
+private:
+    int blocks_per_row_;
+    int block_rows_;
+};
 
-    Node_v1* current_node = maze.node(coords);
+struct MortonLayout {
+    MortonLayout(const int width, const int height) : side_{std::bit_ceil(static_cast<unsigned int>(std::max(width, height)))} {}
 
-    current_node->visited = true;
+    std::size_t size() const { return static_cast<std::size_t>(side_) * side_; }
+    std::size_t index(const int x, const int y) const { return spread_bits(static_cast<std::uint32_t>(x)) | (spread_bits(static_cast<std::uint32_t>(y)) << 1); }
 
-    for (const auto dir : directions) {
-        Coordinates_v2 new_coords{coords_in_direction_v2(coords, dir)};
+private:
+    unsigned int side_;
+
+    // Moves bit n of value to bit 2n.
+    static std::size_t spread_bits(const std::uint32_t value)
+    {
+        std::uint64_t v = value;
+        v = (v | (v << 16)) & 0x0000ffff0000ffff;
+        v = (v | (v <<  8)) & 0x00ff00ff00ff00ff;
+        v = (v | (v <<  4)) & 0x0f0f0f0f0f0f0f0f;
+        v = (v | (v <<  2)) & 0x3333333333333333;
+        v = (v | (v <<  1)) & 0x5555555555555555;
+        return static_cast<std::size_t>(v);
+    }
+};
 
-        if (maze.valid_coords(new_coords)) {
-            Node_v1* next_node = maze.node(new_coords);
+template <typename Layout>
+class Maze_v11 {
+public:
+    using Node = unsigned char;
 
-            if (!next_node->visited) {
-                switch (dir) {
-                case 0:
-                    current_node->has_north_wall = false;
-                    next_node->has_south_wall = false;
-                    break;
-                case 1:
-                    current_node->has_east_wall = false;
-                    next_node->has_west_wall = false;
-                    break;
-                case 2:
-                    current_node->has_south_wall = false;
-                    next_node->has_north_wall = false;
-                    break;
-                case 3:
-                    current_node->has_west_wall = false;
-                    next_node->has_east_wall = false;
-                    break;
-                }
+    enum class Directions { North = 0, East, South, West };
+    enum class WallFlags { North = 0b0001, East = 0b0010, South = 0b0100, West = 0b1000 };
 
-                visit_v2(maze, new_coords);
-            }
+    struct Coordinates { int x, y; };
 
-        }
+    Maze_v11(const int width, const int height, const std::mt19937::result_type seed)
+        : width_{width},
+          height_{height},
+          layout_{width, height},
+          nodes_(layout_.size(), all_walls_),
+          random_generator_(seed),
+          random_dist_{0, 23} {}
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    bool valid_coords(const Coordinates coords) const { return coords.x >= 0 && coords.y >= 0 && coords.x < width_ && coords.y < height_; }
+
+    Coordinates coords_in_direction(const Coordinates coords, const Directions dir) {
+        const Coordinates offset{direction_coords_offset_[static_cast<int>(dir)]};
+        return Coordinates{coords.x + offset.x, coords.y + offset.y};
     }
-}
 
-void visit_v3(Maze_v3& maze, const Coordinates_v2 coords)
-{
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::vector<Directions_v3> Directions_v3{Directions_v3::North, Directions_v3::East, Directions_v3::South, Directions_v3::West};
-    std::shuffle(Directions_v3.begin(), Directions_v3.end(), g);
+    int random_directions_index() { return random_dist_(random_generator_); }
+    const Directions* directions(const int index) const { return all_possible_random_directions[index]; }
+    Directions opposite_direction(const Directions dir) const { return opposite_direction_[static_cast<int>(dir)]; }
+    WallFlags wall_in_direction(const Directions dir) const { return wall_in_direction_[static_cast<int>(dir)]; }
 
-    maze.set_node_visited(coords);
+    Node& node(const Coordinates coords) { return nodes_[layout_.index(coords.x, coords.y)]; };
+    bool node_visited(const Coordinates coords) { return node(coords) & 0b10000; }
+    void set_node_visited(const Coordinates coords) { node(coords) |= 0b10000; }
 
-    for (const auto dir : Directions_v3) {
-        Coordinates_v2 new_coords{coords_in_direction_v3(coords, dir)};
+    bool has_wall(const Coordinates coords, WallFlags wall) { return node(coords) & static_cast<Node>(wall); }
+    void clear_walls(const Coordinates orig, const Coordinates dest, Directions dir) {
+        const WallFlags orig_wall = wall_in_direction_[static_cast<int>(dir)];
+        const WallFlags dest_wall = wall_in_direction_[static_cast<int>(opposite_direction_[static_cast<int>(dir)])];
+        node(orig) &= ~(static_cast<Node>(orig_wall));
+        node(dest) &= ~(static_cast<Node>(dest_wall));
+    }
+
+private:
+    static constexpr Node all_walls_ = static_cast<Node>(WallFlags::North) | static_cast<Node>(WallFlags::East) | static_cast<Node>(WallFlags::South) | static_cast<Node>(WallFlags::West);
+
+    const int width_;
+    const int height_;
+    const Layout layout_;
+    std::vector<Node> nodes_;
+
+    std::mt19937 random_generator_;
+    std::uniform_int_distribution<> random_dist_;
+
+    static constexpr WallFlags wall_in_direction_[4] = { WallFlags::North, WallFlags::East, WallFlags::South, WallFlags::West };
+    static constexpr Directions opposite_direction_[4] = { Directions::South, Directions::West, Directions::North, Directions::East };
+    static constexpr Coordinates direction_coords_offset_[4] = { Coordinates{0, -1}, Coordinates{1, 0}, Coordinates{0, 1}, Coordinates{-1, 0} };
+    static constexpr Directions all_possible_random_directions[24][4] = {
+        {Directions::North, Directions::East,  Directions::South, Directions::West},
+        {Directions::North, Directions::East,  Directions::West,  Directions::South},
+        {Directions::North, Directions::South, Directions::East,  Directions::West},
+        {Directions::North, Directions::South, Directions::West,  Directions::East},
+        {Directions::North, Directions::West,  Directions::East,  Directions::South},
+        {Directions::North, Directions::West,  Directions::South, Directions::East},
+        {Directions::East,  Directions::North, Directions::South, Directions::West},
+        {Directions::East,  Directions::North, Directions::West,  Directions::South},
+        {Directions::East,  Directions::South, Directions::North, Directions::West},
+        {Directions::East,  Directions::South, Directions::West,  Directions::North},
+        {Directions::East,  Directions::West,  Directions::North, Directions::South},
+        {Directions::East,  Directions::West,  Directions::South, Directions::North},
+        {Directions::South, Directions::North, Directions::East,  Directions::West},
+        {Directions::South, Directions::North, Directions::West,  Directions::East},
+        {Directions::South, Directions::East,  Directions::North, Directions::West},
+        {Directions::South, Directions::East,  Directions::West,  Directions::North},
+        {Directions::South, Directions::West,  Directions::North, Directions::East},
+        {Directions::South, Directions::West,  Directions::East,  Directions::North},
+        {Directions::West,  Directions::North, Directions::East,  Directions::South},
+        {Directions::West,  Directions::North, Directions::South, Directions::East},
+        {Directions::West,  Directions::East,  Directions::North, Directions::South},
+        {Directions::West,  Directions::East,  Directions::South, Directions::North},
+        {Directions::West,  Directions::South, Directions::North, Directions::East},
+        {Directions::West,  Directions::South, Directions::East,  Directions::North}};
+};
+
+// Maze_v9 surrounded by a border of sentinel nodes that are marked as visited, so the generator
+// does not need any bounds checks. Nodes are addressed by index into the bordered grid.
+class Maze_v13 {
+public:
+    using Node = unsigned char;
+
+    enum class Directions { North = 0, East, South, West };
+    enum class WallFlags { North = 0b0001, East = 0b0010, South = 0b0100, West = 0b1000 };
+
+    struct Coordinates { int x, y; };
+
+    Maze_v13(const int width, const int height)
+        : width_{width},
+          height_{height},
+          stride_{width + 2},
+          nodes_(static_cast<std::size_t>((width + 2) * (height + 2)), all_walls_),
+          random_device_(),
+          random_generator_(random_device_()),
+          random_dist_{0, 23}
+    {
+        for (int x = 0; x < stride_; ++x) {
+            nodes_[static_cast<std::size_t>(x)] |= 0b10000;
+            nodes_[static_cast<std::size_t>((height_ + 1) * stride_ + x)] |= 0b10000;
+        }
+
+        for (int y = 1; y <= height_; ++y) {
+            nodes_[static_cast<std::size_t>(y * stride_)] |= 0b10000;
+            nodes_[static_cast<std::size_t>(y * stride_ + width_ + 1)] |= 0b10000;
+        }
+    }
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    int index(const Coordinates coords) const { return (coords.y + 1) * stride_ + coords.x + 1; }
+    int index_in_direction(const int idx, const Directions dir) const
+    {
+        const int offsets[4] = { -stride_, 1, stride_, -1 };
+        return idx + offsets[static_cast<int>(dir)];
+    }
+
+    int random_directions_index() { return random_dist_(random_generator_); }
+
+    unsigned int unvisited_neighbours(const int idx) const
+    {
+        const std::size_t i = static_cast<std::size_t>(idx);
+        const std::size_t stride = static_cast<std::size_t>(stride_);
+
+        return ((~static_cast<unsigned int>(nodes_[i - stride]) >> 4) & 1)
+            | (((~static_cast<unsigned int>(nodes_[i + 1]) >> 4) & 1) << 1)
+            | (((~static_cast<unsigned int>(nodes_[i + stride]) >> 4) & 1) << 2)
+            | (((~static_cast<unsigned int>(nodes_[i - 1]) >> 4) & 1) << 3);
+    }
+
+    Directions next_direction(const int permutation, const unsigned int mask) const { return next_direction_[static_cast<std::size_t>(permutation)][mask]; }
+
+    Node& node(const int idx) { return nodes_[static_cast<std::size_t>(idx)]; };
+    bool node_visited(const int idx) { return node(idx) & 0b10000; }
+    void set_node_visited(const int idx) { node(idx) |= 0b10000; }
+
+    bool has_wall(const Coordinates coords, WallFlags wall) { return node(index(coords)) & static_cast<Node>(wall); }
+    void clear_walls(const int orig, const int dest, Directions dir) {
+        const WallFlags orig_wall = wall_in_direction_[static_cast<int>(dir)];
+        const WallFlags dest_wall = wall_in_direction_[static_cast<int>(opposite_direction_[static_cast<int>(dir)])];
+        node(orig) &= ~(static_cast<Node>(orig_wall));
+        node(dest) &= ~(static_cast<Node>(dest_wall));
+    }
+
+private:
+    static constexpr Node all_walls_ = static_cast<Node>(WallFlags::North) | static_cast<Node>(WallFlags::East) | static_cast<Node>(WallFlags::South) | static_cast<Node>(WallFlags::West);
+
+    const int width_;
+    const int height_;
+    const int stride_;
+    std::vector<Node> nodes_;
+
+    std::random_device random_device_;
+    std::mt19937 random_generator_;
+    std::uniform_int_distribution<> random_dist_;
+
+    static constexpr WallFlags wall_in_direction_[4] = { WallFlags::North, WallFlags::East, WallFlags::South, WallFlags::West };
+    static constexpr Directions opposite_direction_[4] = { Directions::South, Directions::West, Directions::North, Directions::East };
+    static constexpr Directions all_possible_random_directions[24][4] = {
+        {Directions::North, Directions::East,  Directions::South, Directions::West},
+        {Directions::North, Directions::East,  Directions::West,  Directions::South},
+        {Directions::North, Directions::South, Directions::East,  Directions::West},
+        {Directions::North, Directions::South, Directions::West,  Directions::East},
+        {Directions::North, Directions::West,  Directions::East,  Directions::South},
+        {Directions::North, Directions::West,  Directions::South, Directions::East},
+        {Directions::East,  Directions::North, Directions::South, Directions::West},
+        {Directions::East,  Directions::North, Directions::West,  Directions::South},
+        {Directions::East,  Directions::South, Directions::North, Directions::West},
+        {Directions::East,  Directions::South, Directions::West,  Directions::North},
+        {Directions::East,  Directions::West,  Directions::North, Directions::South},
+        {Directions::East,  Directions::West,  Directions::South, Directions::North},
+        {Directions::South, Directions::North, Directions::East,  Directions::West},
+        {Directions::South, Directions::North, Directions::West,  Directions::East},
+        {Directions::South, Directions::East,  Directions::North, Directions::West},
+        {Directions::South, Directions::East,  Directions::West,  Directions::North},
+        {Directions::South, Directions::West,  Directions::North, Directions::East},
+        {Directions::South, Directions::West,  Directions::East,  Directions::North},
+        {Directions::West,  Directions::North, Directions::East,  Directions::South},
+        {Directions::West,  Directions::North, Directions::South, Directions::East},
+        {Directions::West,  Directions::East,  Directions::North, Directions::South},
+        {Directions::West,  Directions::East,  Directions::South, Directions::North},
+        {Directions::West,  Directions::South, Directions::North, Directions::East},
+        {Directions::West,  Directions::South, Directions::East,  Directions::North}};
+
+    static constexpr std::array<std::array<Directions, 16>, 24> next_direction_ = [] {
+        std::array<std::array<Directions, 16>, 24> table{};
+
+        for (std::size_t permutation = 0; permutation < 24; ++permutation) {
+            for (unsigned int mask = 1; mask < 16; ++mask) {
+                for (const auto dir : all_possible_random_directions[permutation]) {
+                    if (mask & (1u << static_cast<int>(dir))) {
+                        table[permutation][mask] = dir;
+                        break;
+                    }
+                }
+            }
+        }
+
+        return table;
+    }();
+};
+
+template <int N>
+constexpr auto make_direction_permutations()
+{
+    constexpr std::size_t count = [] {
+        std::size_t factorial = 1;
+
+        for (int i = 2; i <= N; ++i)
+            factorial *= static_cast<std::size_t>(i);
+
+        return factorial;
+    }();
+
+    std::array<std::array<std::uint8_t, N>, count> permutations{};
+    std::array<std::uint8_t, N> directions{};
+
+    for (std::size_t i = 0; i < directions.size(); ++i)
+        directions[i] = static_cast<std::uint8_t>(i);
+
+    for (auto& permutation : permutations) {
+        permutation = directions;
+        std::next_permutation(directions.begin(), directions.end());
+    }
+
+    return permutations;
+}
+
+class SquareTopology {
+public:
+    static constexpr int num_directions = 4;
+
+    struct Coordinates { int x, y; };
+
+    SquareTopology(const int width, const int height) : width_{width}, height_{height} {}
+
+    std::size_t size() const { return static_cast<std::size_t>(width_ * height_); }
+    std::size_t index(const Coordinates coords) const { return static_cast<std::size_t>(coords.y * width_ + coords.x); }
+    bool valid_coords(const Coordinates coords) const { return coords.x >= 0 && coords.y >= 0 && coords.x < width_ && coords.y < height_; }
+
+    static Coordinates coords_in_direction(const Coordinates coords, const int dir) { return {coords.x + offsets_[dir].x, coords.y + offsets_[dir].y}; }
+    static int opposite_direction(const int dir) { return (dir + 2) % 4; }
+
+private:
+    int width_;
+    int height_;
+
+    static constexpr Coordinates offsets_[4] = { {0, -1}, {1, 0}, {0, 1}, {-1, 0} };
+};
+
+class CubeTopology {
+public:
+    static constexpr int num_directions = 6;
+
+    struct Coordinates { int x, y, z; };
+
+    CubeTopology(const int width, const int height, const int depth) : width_{width}, height_{height}, depth_{depth} {}
+
+    std::size_t size() const { return static_cast<std::size_t>(width_ * height_ * depth_); }
+    std::size_t index(const Coordinates coords) const { return static_cast<std::size_t>((coords.z * height_ + coords.y) * width_ + coords.x); }
+    bool valid_coords(const Coordinates coords) const { return coords.x >= 0 && coords.y >= 0 && coords.z >= 0 && coords.x < width_ && coords.y < height_ && coords.z < depth_; }
+
+    static Coordinates coords_in_direction(const Coordinates coords, const int dir) { return {coords.x + offsets_[dir].x, coords.y + offsets_[dir].y, coords.z + offsets_[dir].z}; }
+    static int opposite_direction(const int dir) { return opposite_direction_[dir]; }
+
+private:
+    int width_;
+    int height_;
+    int depth_;
+
+    static constexpr Coordinates offsets_[6] = { {0, -1, 0}, {1, 0, 0}, {0, 1, 0}, {-1, 0, 0}, {0, 0, -1}, {0, 0, 1} };
+    static constexpr int opposite_direction_[6] = { 2, 3, 0, 1, 5, 4 };
+};
+
+class HexTopology {
+public:
+    static constexpr int num_directions = 6;
+
+    struct Coordinates { int q, r; };
+
+    HexTopology(const int width, const int height) : width_{width}, height_{height} {}
+
+    std::size_t size() const { return static_cast<std::size_t>(width_ * height_); }
+    std::size_t index(const Coordinates coords) const { return static_cast<std::size_t>(coords.r * width_ + coords.q); }
+    bool valid_coords(const Coordinates coords) const { return coords.q >= 0 && coords.r >= 0 && coords.q < width_ && coords.r < height_; }
+
+    static Coordinates coords_in_direction(const Coordinates coords, const int dir) { return {coords.q + offsets_[dir].q, coords.r + offsets_[dir].r}; }
+    static int opposite_direction(const int dir) { return (dir + 3) % 6; }
+
+private:
+    int width_;
+    int height_;
+
+    static constexpr Coordinates offsets_[6] = { {1, 0}, {1, -1}, {0, -1}, {-1, 0}, {-1, 1}, {0, 1} };
+};
+
+template <typename Topology>
+class Maze_v14 {
+public:
+    using Node = unsigned char;
+    using Coordinates = typename Topology::Coordinates;
+
+    static constexpr int num_directions = Topology::num_directions;
+
+    static_assert(num_directions < 8, "walls and visited flag have to fit into a Node");
+
+    explicit Maze_v14(const Topology& topology)
+        : topology_{topology},
+          nodes_(topology.size(), all_walls_),
+          random_device_(),
+          random_generator_(random_device_()),
+          random_dist_{0, static_cast<int>(direction_permutations_.size()) - 1} {}
+
+    const Topology& topology() const { return topology_; }
+
+    bool valid_coords(const Coordinates coords) const { return topology_.valid_coords(coords); }
+    Coordinates coords_in_direction(const Coordinates coords, const int dir) const { return Topology::coords_in_direction(coords, dir); }
+
+    const std::uint8_t* random_directions() { return direction_permutations_[static_cast<std::size_t>(random_dist_(random_generator_))].data(); }
+
+    Node& node(const Coordinates coords) { return nodes_[topology_.index(coords)]; };
+    bool node_visited(const Coordinates coords) { return node(coords) & visited_flag_; }
+    void set_node_visited(const Coordinates coords) { node(coords) |= visited_flag_; }
+
+    bool has_wall(const Coordinates coords, const int dir) { return node(coords) & (1 << dir); }
+    void clear_walls(const Coordinates orig, const Coordinates dest, const int dir) {
+        node(orig) &= static_cast<Node>(~(1 << dir));
+        node(dest) &= static_cast<Node>(~(1 << Topology::opposite_direction(dir)));
+    }
+
+private:
+    static constexpr Node visited_flag_ = 1 << num_directions;
+    static constexpr Node all_walls_ = visited_flag_ - 1;
+    static constexpr auto direction_permutations_ = make_direction_permutations<num_directions>();
+
+    const Topology topology_;
+    std::vector<Node> nodes_;
+
+    std::random_device random_device_;
+    std::mt19937 random_generator_;
+    std::uniform_int_distribution<> random_dist_;
+};
+
+class ConstexprRandom {
+public:
+    constexpr explicit ConstexprRandom(const std::uint64_t seed)
+    {
+        (*this)();
+        state_ += seed;
+        (*this)();
+    }
+
+    constexpr std::uint32_t operator()()
+    {
+        const std::uint64_t old_state = state_;
+        state_ = old_state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return std::rotr(static_cast<std::uint32_t>(((old_state >> 18) ^ old_state) >> 27), static_cast<int>(old_state >> 59));
+    }
+
+    constexpr int below(const int bound) { return static_cast<int>((static_cast<std::uint64_t>((*this)()) * static_cast<std::uint64_t>(bound)) >> 32); }
+
+private:
+    std::uint64_t state_ = 0;
+};
+
+template <int Width, int Height>
+class Maze_v12 {
+public:
+    using Node = unsigned char;
+
+    enum class Directions { North = 0, East, South, West };
+    enum class WallFlags { North = 0b0001, East = 0b0010, South = 0b0100, West = 0b1000 };
+
+    struct Coordinates { int x, y; };
+
+    constexpr Maze_v12() { nodes_.fill(all_walls_); }
+
+    static constexpr int width() { return Width; }
+    static constexpr int height() { return Height; }
+
+    static constexpr bool valid_coords(const Coordinates coords) { return coords.x >= 0 && coords.y >= 0 && coords.x < Width && coords.y < Height; }
+
+    static constexpr int index(const Coordinates coords) { return coords.y * Width + coords.x; }
+    static constexpr int index_in_direction(const int idx, const Directions dir) { return idx + index_offset_[static_cast<int>(dir)]; }
+
+    static constexpr bool has_neighbour(const int idx, const Directions dir)
+    {
+        switch (dir) {
+        case Directions::North: return idx >= Width;
+        case Directions::East:  return idx % Width != Width - 1;
+        case Directions::South: return idx < Width * (Height - 1);
+        case Directions::West:  return idx % Width != 0;
+        }
+
+        return false;
+    }
+
+    static constexpr const Directions* directions(const int permutation) { return all_possible_random_directions[permutation]; }
+
+    constexpr bool node_visited(const int idx) const { return nodes_[static_cast<std::size_t>(idx)] & 0b10000; }
+    constexpr void set_node_visited(const int idx) { nodes_[static_cast<std::size_t>(idx)] |= 0b10000; }
+
+    constexpr bool has_wall(const Coordinates coords, WallFlags wall) const { return nodes_[static_cast<std::size_t>(index(coords))] & static_cast<Node>(wall); }
+    constexpr void clear_walls(const int orig, const int dest, Directions dir) {
+        const WallFlags orig_wall = wall_in_direction_[static_cast<int>(dir)];
+        const WallFlags dest_wall = wall_in_direction_[static_cast<int>(opposite_direction_[static_cast<int>(dir)])];
+        nodes_[static_cast<std::size_t>(orig)] &= static_cast<Node>(~static_cast<Node>(orig_wall));
+        nodes_[static_cast<std::size_t>(dest)] &= static_cast<Node>(~static_cast<Node>(dest_wall));
+    }
+
+private:
+    static constexpr Node all_walls_ = static_cast<Node>(WallFlags::North) | static_cast<Node>(WallFlags::East) | static_cast<Node>(WallFlags::South) | static_cast<Node>(WallFlags::West);
+
+    std::array<Node, static_cast<std::size_t>(Width * Height)> nodes_{};
+
+    static constexpr int index_offset_[4] = { -Width, 1, Width, -1 };
+    static constexpr WallFlags wall_in_direction_[4] = { WallFlags::North, WallFlags::East, WallFlags::South, WallFlags::West };
+    static constexpr Directions opposite_direction_[4] = { Directions::South, Directions::West, Directions::North, Directions::East };
+    static constexpr Directions all_possible_random_directions[24][4] = {
+        {Directions::North, Directions::East,  Directions::South, Directions::West},
+        {Directions::North, Directions::East,  Directions::West,  Directions::South},
+        {Directions::North, Directions::South, Directions::East,  Directions::West},
+        {Directions::North, Directions::South, Directions::West,  Directions::East},
+        {Directions::North, Directions::West,  Directions::East,  Directions::South},
+        {Directions::North, Directions::West,  Directions::South, Directions::East},
+        {Directions::East,  Directions::North, Directions::South, Directions::West},
+        {Directions::East,  Directions::North, Directions::West,  Directions::South},
+        {Directions::East,  Directions::South, Directions::North, Directions::West},
+        {Directions::East,  Directions::South, Directions::West,  Directions::North},
+        {Directions::East,  Directions::West,  Directions::North, Directions::South},
+        {Directions::East,  Directions::West,  Directions::South, Directions::North},
+        {Directions::South, Directions::North, Directions::East,  Directions::West},
+        {Directions::South, Directions::North, Directions::West,  Directions::East},
+        {Directions::South, Directions::East,  Directions::North, Directions::West},
+        {Directions::South, Directions::East,  Directions::West,  Directions::North},
+        {Directions::South, Directions::West,  Directions::North, Directions::East},
+        {Directions::South, Directions::West,  Directions::East,  Directions::North},
+        {Directions::West,  Directions::North, Directions::East,  Directions::South},
+        {Directions::West,  Directions::North, Directions::South, Directions::East},
+        {Directions::West,  Directions::East,  Directions::North, Directions::South},
+        {Directions::West,  Directions::East,  Directions::South, Directions::North},
+        {Directions::West,  Directions::South, Directions::North, Directions::East},
+        {Directions::West,  Directions::South, Directions::East,  Directions::North}};
+};
+
+struct StackNode_v1 {
+    Maze_v7::Coordinates coords;
+    std::vector<Maze_v7::Directions> check_directions;
+};
+
+struct StackNode_v2 {
+    Maze_v8::Coordinates coords;
+    const std::vector<Maze_v8::Directions>* check_directions;
+    int rnd_idx;
+};
+
+struct StackNode_v3 {
+    StackNode_v3(const Maze_v8::Coordinates c, const std::vector<Maze_v8::Directions>* d) : coords{c}, check_directions{d}, rnd_idx{0} {}
+    Maze_v8::Coordinates coords;
+    const std::vector<Maze_v8::Directions>* check_directions;
+    int rnd_idx;
+};
+
+struct StackNode_v4 {
+    StackNode_v4(const Maze_v9::Coordinates c, const Maze_v9::Directions* d) : coords{c}, check_directions{d}, rnd_idx{0} {}
+
+    const Maze_v9::Coordinates coords;
+    const Maze_v9::Directions* check_directions;
+    int rnd_idx;
+};
+
+class StackNode_v5 {
+public:
+    StackNode_v5(const Maze_v9::Directions entry_direction, const int permutation) : bits_{static_cast<std::uint16_t>(static_cast<int>(entry_direction) | (permutation << 2))} {}
+
+    Maze_v9::Directions entry_direction() const { return static_cast<Maze_v9::Directions>(bits_ & 0b11); }
+    int permutation() const { return (bits_ >> 2) & 0b11111; }
+    int rnd_idx() const { return bits_ >> 7; }
+    void next_rnd_idx() { bits_ = static_cast<std::uint16_t>(bits_ + (1 << 7)); }
+
+private:
+    std::uint16_t bits_;
+};
+
+struct StackNode_v6 {
+    StackNode_v6(const Maze_v10::Coordinates c, const Maze_v10::Directions* d) : coords{c}, check_directions{d}, rnd_idx{0} {}
+
+    Maze_v10::Coordinates coords;
+    const Maze_v10::Directions* check_directions;
+    int rnd_idx;
+};
+
+template <typename Maze>
+class StackNode_v7 {
+public:
+    StackNode_v7(const typename Maze::Directions entry_direction, const int permutation) : bits_{static_cast<std::uint16_t>(static_cast<int>(entry_direction) | (permutation << 2))} {}
+
+    typename Maze::Directions entry_direction() const { return static_cast<typename Maze::Directions>(bits_ & 0b11); }
+    int permutation() const { return (bits_ >> 2) & 0b11111; }
+    int rnd_idx() const { return bits_ >> 7; }
+    void next_rnd_idx() { bits_ = static_cast<std::uint16_t>(bits_ + (1 << 7)); }
+
+private:
+    std::uint16_t bits_;
+};
+
+struct StackNode_v8 {
+    int idx;
+    int permutation;
+};
+
+template <typename Topology>
+struct StackNode_v9 {
+    StackNode_v9(const typename Topology::Coordinates c, const std::uint8_t* d) : coords{c}, check_directions{d}, rnd_idx{0} {}
+
+    typename Topology::Coordinates coords;
+    const std::uint8_t* check_directions;
+    int rnd_idx;
+};
+
+void coord_in_direction_v1(const int x, const int y, const int dir, int* nx, int* ny)
+{
+    *nx = x;
+    *ny = y;
+
+    switch (dir) {
+    case 0:
+        *nx = x;
+        *ny = y - 1;
+        break;
+    case 1:
+        *nx = x + 1;
+        *ny = y;
+        break;
+    case 2:
+        *nx = x;
+        *ny = y + 1;
+        break;
+    case 3:
+        *nx = x - 1;
+        *ny = y;
+        break;
+    }
+}
+
+Coordinates_v2 coords_in_direction_v2(const Coordinates_v2 coords, const int dir)
+{
+    Coordinates_v2 new_coords{coords};
+
+    switch (dir) {
+    case 0:
+        new_coords.y = coords.y - 1;
+        break;
+    case 1:
+        new_coords.x = coords.x + 1;
+        break;
+    case 2:
+        new_coords.y = coords.y + 1;
+        break;
+    case 3:
+        new_coords.x = coords.x - 1;
+        break;
+    }
+
+    return new_coords;
+}
+
+Coordinates_v2 coords_in_direction_v3(const Coordinates_v2 coords, const Directions_v3 dir)
+{
+    Coordinates_v2 new_coords{coords};
+
+    switch (dir) {
+    case Directions_v3::North:
+        new_coords.y = coords.y - 1;
+        break;
+    case Directions_v3::East:
+        new_coords.x = coords.x + 1;
+        break;
+    case Directions_v3::South:
+        new_coords.y = coords.y + 1;
+        break;
+    case Directions_v3::West:
+        new_coords.x = coords.x - 1;
+        break;
+    }
+
+    return new_coords;
+}
+
+Node_v1* node_at_v1(Node_v1* maze, const int num_cols, const int x, const int y)
+{
+    return &maze[y * num_cols + x];
+}
+
+void visit_v1(Node_v1* maze, const int num_rows, const int num_cols, const int x, const int y)
+{
+    std::random_device rd;
+    std::mt19937 g(rd());
+    std::vector<int> directions{0, 1, 2, 3};
+    std::shuffle(directions.begin(), directions.end(), g);
+
+    Node_v1* current_node = node_at_v1(maze, num_cols, x, y);
+
+    current_node->visited = true;
+
+    for (auto dir : directions) {
+        int nx, ny;
+        coord_in_direction_v1(x, y, dir, &nx, &ny);
+
+        if (nx >= 0 && ny >= 0 && nx < num_cols && ny < num_rows) {
+            Node_v1* next_node = node_at_v1(maze, num_cols, nx, ny);
+
+            if (!next_node->visited) {
+                switch (dir) {
+                case 0:
+                    current_node->has_north_wall = false;
+                    next_node->has_south_wall = false;
+                    break;
+                case 1:
+                    current_node->has_east_wall = false;
+                    next_node->has_west_wall = false;
+                    break;
+                case 2:
+                    current_node->has_south_wall = false;
+                    next_node->has_north_wall = false;
+                    break;
+                case 3:
+                    current_node->has_west_wall = false;
+                    next_node->has_east_wall = false;
+                    break;
+                }
+
+                visit_v1(maze, num_rows, num_cols, nx, ny);
+            }
+
+        }
+    }
+}
+
+void visit_v2(Maze_v2& maze, const Coordinates_v2 coords)
+{
+    std::random_device rd;
+    std::mt19937 g(rd());
+    std::vector<int> directions{0, 1, 2, 3};
+    std::shuffle(directions.begin(), directions.end(), g);
+
+    Node_v1* current_node = maze.node(coords);
+
+    current_node->visited = true;
+
+    for (const auto dir : directions) {
+        Coordinates_v2 new_coords{coords_in_direction_v2(coords, dir)};
+
+        if (maze.valid_coords(new_coords)) {
+            Node_v1* next_node = maze.node(new_coords);
+
+            if (!next_node->visited) {
+                switch (dir) {
+                case 0:
+                    current_node->has_north_wall = false;
+                    next_node->has_south_wall = false;
+                    break;
+                case 1:
+                    current_node->has_east_wall = false;
+                    next_node->has_west_wall = false;
+                    break;
+                case 2:
+                    current_node->has_south_wall = false;
+                    next_node->has_north_wall = false;
+                    break;
+                case 3:
+                    current_node->has_west_wall = false;
+                    next_node->has_east_wall = false;
+                    break;
+                }
+
+                visit_v2(maze, new_coords);
+            }
+
+        }
+    }
+}
+
+void visit_v3(Maze_v3& maze, const Coordinates_v2 coords)
+{
+    std::random_device rd;
+    std::mt19937 g(rd());
+    std::vector<Directions_v3> Directions_v3{Directions_v3::North, Directions_v3::East, Directions_v3::South, Directions_v3::West};
+    std::shuffle(Directions_v3.begin(), Directions_v3.end(), g);
+
+    maze.set_node_visited(coords);
+
+    for (const auto dir : Directions_v3) {
+        Coordinates_v2 new_coords{coords_in_direction_v3(coords, dir)};
 
         if (maze.valid_coords(new_coords)) {
             if (!maze.node_visited(new_coords)) {
@@ -756,274 +1429,1530 @@ void visit_v3(Maze_v3& maze, const Coordinates_v2 coords)
                     break;
                 }
 
-                visit_v3(maze, new_coords);
+                visit_v3(maze, new_coords);
+            }
+        }
+    }
+}
+
+void visit_v4(Maze_v4& maze, const Maze_v4::Coordinates coords)
+{
+    std::random_device rd;
+    std::mt19937 g(rd());
+    std::vector<Maze_v4::Directions> directions{Maze_v4::Directions::North, Maze_v4::Directions::East, Maze_v4::Directions::South, Maze_v4::Directions::West};
+    std::shuffle(directions.begin(), directions.end(), g);
+
+    maze.set_node_visited(coords);
+
+    for (const auto dir : directions) {
+        Maze_v4::Coordinates new_coords{maze.coords_in_direction(coords, dir)};
+
+        if (maze.valid_coords(new_coords)) {
+            if (!maze.node_visited(new_coords)) {
+                maze.clear_walls(coords, new_coords, dir);
+                visit_v4(maze, new_coords);
+            }
+        }
+    }
+}
+
+void visit_v5(Maze_v5& maze, const Maze_v5::Coordinates coords)
+{
+    maze.set_node_visited(coords);
+
+    for (const auto dir : maze.random_directions()) {
+        Maze_v5::Coordinates new_coords{maze.coords_in_direction(coords, dir)};
+
+        if (maze.valid_coords(new_coords)) {
+            if (!maze.node_visited(new_coords)) {
+                maze.clear_walls(coords, new_coords, dir);
+                visit_v5(maze, new_coords);
+            }
+        }
+    }
+}
+
+void visit_v6(Maze_v6& maze, const Maze_v6::Coordinates coords)
+{
+    maze.set_node_visited(coords);
+
+    for (const auto dir : maze.random_directions()) {
+        Maze_v6::Coordinates new_coords{maze.coords_in_direction(coords, dir)};
+
+        if (maze.valid_coords(new_coords)) {
+            if (!maze.node_visited(new_coords)) {
+                maze.clear_walls(coords, new_coords, dir);
+                visit_v6(maze, new_coords);
+            }
+        }
+    }
+}
+
+void visit_v7(Maze_v7& maze, const Maze_v7::Coordinates coords)
+{
+    maze.set_node_visited(coords);
+
+    for (const auto dir : maze.random_directions()) {
+        Maze_v7::Coordinates next_coords{maze.coords_in_direction(coords, dir)};
+
+        if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
+            maze.clear_walls(coords, next_coords, dir);
+            visit_v7(maze, next_coords);
+        }
+    }
+}
+
+void generate_v1(Maze_v7& maze, const Maze_v7::Coordinates starting_point)
+{
+    std::stack<StackNode_v1> stack;
+
+    auto rd{maze.random_directions()};
+    stack.push({starting_point, rd});
+
+    while (!stack.empty()) {
+        StackNode_v1& current_node = stack.top();
+        maze.set_node_visited(current_node.coords);
+
+        if (!current_node.check_directions.empty()) {
+            auto dir = current_node.check_directions.back();
+            current_node.check_directions.pop_back();
+
+            Maze_v7::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
+
+            if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
+                maze.clear_walls(current_node.coords, next_coords, dir);
+                maze.set_node_visited(next_coords);
+
+                auto rd2{maze.random_directions()};
+                stack.push({next_coords, rd2});
+            }
+        } else {
+            stack.pop();
+        }
+    }
+}
+
+void generate_v2(Maze_v7& maze, const Maze_v7::Coordinates starting_point)
+{
+    std::stack<StackNode_v1> stack;
+
+    maze.set_node_visited(starting_point);
+    stack.push({starting_point, maze.random_directions()});
+
+    while (!stack.empty()) {
+        StackNode_v1& current_node = stack.top();
+
+        if (!current_node.check_directions.empty()) {
+            bool keep_checking = true;
+
+            while (keep_checking && !current_node.check_directions.empty()) {
+                const auto dir = current_node.check_directions.back();
+                current_node.check_directions.pop_back();
+
+                Maze_v7::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
+
+                if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
+                    maze.clear_walls(current_node.coords, next_coords, dir);
+                    maze.set_node_visited(next_coords);
+
+                    stack.push({next_coords, maze.random_directions()});
+                    keep_checking = false;
+                }
+            }
+        } else {
+            stack.pop();
+        }
+    }
+}
+
+void generate_v3(Maze_v8& maze, const Maze_v8::Coordinates starting_point)
+{
+    std::stack<StackNode_v2> stack;
+
+    maze.set_node_visited(starting_point);
+    stack.push({starting_point, maze.random_directions(), 0});
+
+    while (!stack.empty()) {
+        StackNode_v2& current_node = stack.top();
+
+        if (current_node.rnd_idx < 4) {
+            bool keep_checking = true;
+
+            while (keep_checking && current_node.rnd_idx < 4) {
+                const auto dir = current_node.check_directions->at(static_cast<std::size_t>(current_node.rnd_idx));
+                ++current_node.rnd_idx;
+
+                Maze_v8::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
+
+                if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
+                    maze.clear_walls(current_node.coords, next_coords, dir);
+                    maze.set_node_visited(next_coords);
+
+                    stack.push({next_coords, maze.random_directions(), 0});
+                    keep_checking = false;
+                }
+            }
+        } else {
+            stack.pop();
+        }
+    }
+}
+
+void generate_v4(Maze_v8& maze, const Maze_v8::Coordinates starting_point)
+{
+    std::vector<StackNode_v3> stack;
+
+    maze.set_node_visited(starting_point);
+    stack.emplace_back(starting_point, maze.random_directions());
+
+    while (!stack.empty()) {
+        StackNode_v3& current_node = stack.back();
+
+        if (current_node.rnd_idx < 4) {
+            bool keep_checking = true;
+
+            while (keep_checking && current_node.rnd_idx < 4) {
+                const auto dir = current_node.check_directions->at(static_cast<std::size_t>(current_node.rnd_idx));
+                ++current_node.rnd_idx;
+
+                Maze_v8::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
+
+                if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
+                    maze.clear_walls(current_node.coords, next_coords, dir);
+                    maze.set_node_visited(next_coords);
+
+                    stack.emplace_back(next_coords, maze.random_directions());
+                    keep_checking = false;
+                }
+            }
+        } else {
+            stack.pop_back();
+        }
+    }
+}
+
+void generate_v5(Maze_v9& maze, const Maze_v9::Coordinates starting_point)
+{
+    std::vector<StackNode_v4> stack;
+
+    maze.set_node_visited(starting_point);
+    stack.emplace_back(starting_point, maze.random_directions());
+
+    while (!stack.empty()) {
+        StackNode_v4& current_node = stack.back();
+
+        if (current_node.rnd_idx < 4) {
+            bool keep_checking = true;
+
+            while (keep_checking && current_node.rnd_idx < 4) {
+                const auto dir = current_node.check_directions[current_node.rnd_idx];
+                ++current_node.rnd_idx;
+
+                Maze_v9::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
+
+                if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
+                    maze.clear_walls(current_node.coords, next_coords, dir);
+                    maze.set_node_visited(next_coords);
+
+                    stack.emplace_back(next_coords, maze.random_directions());
+                    keep_checking = false;
+                }
+            }
+        } else {
+            stack.pop_back();
+        }
+    }
+}
+
+void generate_v6(Maze_v9& maze, const Maze_v9::Coordinates starting_point)
+{
+    std::vector<StackNode_v4> stack;
+
+    maze.set_node_visited(starting_point);
+    stack.emplace_back(starting_point, maze.random_directions());
+
+    while (!stack.empty()) {
+        StackNode_v4& current_node = stack.back();
+
+        if (current_node.rnd_idx < 4) {
+            bool keep_checking = true;
+
+            while (keep_checking && current_node.rnd_idx < 4) {
+                const auto dir = current_node.check_directions[current_node.rnd_idx];
+                ++current_node.rnd_idx;
+
+                Maze_v9::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
+
+                if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
+                    maze.clear_walls(current_node.coords, next_coords, dir);
+                    maze.set_node_visited(next_coords);
+
+                    stack.emplace_back(next_coords, maze.random_directions());
+                    keep_checking = false;
+                }
+            }
+        } else {
+            stack.pop_back();
+        }
+    }
+}
+
+void generate_v7(Maze_v9& maze, const Maze_v9::Coordinates starting_point)
+{
+    std::vector<StackNode_v5> stack;
+    Maze_v9::Coordinates coords{starting_point};
+
+    maze.set_node_visited(starting_point);
+    stack.emplace_back(Maze_v9::Directions::North, maze.random_directions_index());
+
+    while (!stack.empty()) {
+        StackNode_v5& current_node = stack.back();
+
+        if (current_node.rnd_idx() < 4) {
+            const Maze_v9::Directions* check_directions = maze.directions(current_node.permutation());
+            bool keep_checking = true;
+
+            while (keep_checking && current_node.rnd_idx() < 4) {
+                const auto dir = check_directions[current_node.rnd_idx()];
+                current_node.next_rnd_idx();
+
+                Maze_v9::Coordinates next_coords{maze.coords_in_direction(coords, dir)};
+
+                if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
+                    maze.clear_walls(coords, next_coords, dir);
+                    maze.set_node_visited(next_coords);
+
+                    coords = next_coords;
+                    stack.emplace_back(dir, maze.random_directions_index());
+                    keep_checking = false;
+                }
+            }
+        } else {
+            coords = maze.coords_in_direction(coords, maze.opposite_direction(current_node.entry_direction()));
+            stack.pop_back();
+        }
+    }
+}
+
+void generate_v8(Maze_v10& maze, const Maze_v10::Coordinates starting_point, std::vector<StackNode_v6>& stack)
+{
+    stack.clear();
+
+    maze.set_node_visited(starting_point);
+    stack.emplace_back(starting_point, maze.random_directions());
+
+    while (!stack.empty()) {
+        StackNode_v6& current_node = stack.back();
+
+        if (current_node.rnd_idx < 4) {
+            bool keep_checking = true;
+
+            while (keep_checking && current_node.rnd_idx < 4) {
+                const auto dir = current_node.check_directions[current_node.rnd_idx];
+                ++current_node.rnd_idx;
+
+                Maze_v10::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
+
+                if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
+                    maze.clear_walls(current_node.coords, next_coords, dir);
+                    maze.set_node_visited(next_coords);
+
+                    stack.emplace_back(next_coords, maze.random_directions());
+                    keep_checking = false;
+                }
+            }
+        } else {
+            stack.pop_back();
+        }
+    }
+}
+
+template <typename Maze>
+void generate_v9(Maze& maze, const typename Maze::Coordinates starting_point)
+{
+    std::vector<StackNode_v7<Maze>> stack;
+    typename Maze::Coordinates coords{starting_point};
+
+    maze.set_node_visited(starting_point);
+    stack.emplace_back(Maze::Directions::North, maze.random_directions_index());
+
+    while (!stack.empty()) {
+        StackNode_v7<Maze>& current_node = stack.back();
+
+        if (current_node.rnd_idx() < 4) {
+            const typename Maze::Directions* check_directions = maze.directions(current_node.permutation());
+            bool keep_checking = true;
+
+            while (keep_checking && current_node.rnd_idx() < 4) {
+                const auto dir = check_directions[current_node.rnd_idx()];
+                current_node.next_rnd_idx();
+
+                typename Maze::Coordinates next_coords{maze.coords_in_direction(coords, dir)};
+
+                if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
+                    maze.clear_walls(coords, next_coords, dir);
+                    maze.set_node_visited(next_coords);
+
+                    coords = next_coords;
+                    stack.emplace_back(dir, maze.random_directions_index());
+                    keep_checking = false;
+                }
+            }
+        } else {
+            coords = maze.coords_in_direction(coords, maze.opposite_direction(current_node.entry_direction()));
+            stack.pop_back();
+        }
+    }
+}
+
+template <typename Maze>
+std::size_t random_walk(Maze& maze, const std::size_t steps, std::mt19937& random_generator)
+{
+    constexpr std::size_t walk_length = 64;
+    std::uniform_int_distribution<int> random_x{0, maze.width() - 1};
+    std::uniform_int_distribution<int> random_y{0, maze.height() - 1};
+
+    typename Maze::Coordinates coords{0, 0};
+    std::size_t east_walls = 0;
+
+    for (std::size_t step = 0; step < steps; ++step) {
+        if (step % walk_length == 0)
+            coords = {random_x(random_generator), random_y(random_generator)};
+
+        const auto dir = static_cast<typename Maze::Directions>(random_generator() & 0b11);
+
+        if (!maze.has_wall(coords, maze.wall_in_direction(dir)))
+            coords = maze.coords_in_direction(coords, dir);
+
+        east_walls += maze.has_wall(coords, Maze::WallFlags::East);
+    }
+
+    return east_walls;
+}
+
+class MazeBatchGenerator {
+public:
+    MazeBatchGenerator(const int width, const int height, const std::mt19937::result_type seed) : maze_{width, height, seed} {}
+
+    const Maze_v10& generate()
+    {
+        maze_.reset();
+        generate_v8(maze_, {0, 0}, stack_);
+        return maze_;
+    }
+
+private:
+    Maze_v10 maze_;
+    std::vector<StackNode_v6> stack_;
+};
+
+class MazeBatchPool {
+public:
+    MazeBatchPool(const int width, const int height, const int num_threads, const std::mt19937::result_type seed) : pool_{num_threads}
+    {
+        generators_.reserve(static_cast<std::size_t>(pool_.size()));
+
+        for (int part = 0; part < pool_.size(); ++part)
+            generators_.emplace_back(width, height, seed + static_cast<std::mt19937::result_type>(part));
+    }
+
+    template <typename Callback>
+    void generate(const int count, Callback callback)
+    {
+        const int num_threads = pool_.size();
+
+        pool_.run([&](const int part) {
+            MazeBatchGenerator& generator = generators_[static_cast<std::size_t>(part)];
+            const int part_count = count / num_threads + (part < count % num_threads ? 1 : 0);
+
+            for (int i = 0; i < part_count; ++i)
+                callback(generator.generate());
+        });
+    }
+
+private:
+    ThreadPool pool_;
+    std::vector<MazeBatchGenerator> generators_;
+};
+
+constexpr std::uint64_t mix_seed(std::uint64_t value)
+{
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+// Chunks are seeded from (chunk_x, chunk_y, world_seed). The door between two chunks is derived
+// from the seed of the chunk west or north of it, so both chunks agree on it independently.
+class ChunkedMaze {
+public:
+    ChunkedMaze(const int chunk_size, const std::uint64_t world_seed, const std::size_t cache_capacity)
+        : chunk_size_{chunk_size}, world_seed_{world_seed}, cache_capacity_{cache_capacity}
+    {
+        if (chunk_size < 2 || cache_capacity < 1)
+            throw std::runtime_error{"invalid chunk size or cache capacity"};
+
+        chunk_index_.reserve(cache_capacity);
+    }
+
+    int chunk_size() const { return chunk_size_; }
+    std::size_t cached_chunks() const { return chunks_.size(); }
+
+    const Maze_v10& chunk(const int chunk_x, const int chunk_y)
+    {
+        const std::uint64_t key = chunk_key(chunk_x, chunk_y);
+        const auto cached = chunk_index_.find(key);
+
+        if (cached != chunk_index_.end()) {
+            chunks_.splice(chunks_.begin(), chunks_, cached->second);
+            return cached->second->maze;
+        }
+
+        if (chunks_.size() < cache_capacity_) {
+            chunks_.emplace_front(key, chunk_size_);
+        } else {
+            chunk_index_.erase(chunks_.back().key);
+            chunks_.splice(chunks_.begin(), chunks_, std::prev(chunks_.end()));
+            chunks_.front().key = key;
+        }
+
+        chunk_index_.emplace(key, chunks_.begin());
+
+        Maze_v10& maze = chunks_.front().maze;
+        generate_chunk(maze, chunk_x, chunk_y);
+        return maze;
+    }
+
+    bool has_wall(const std::int64_t x, const std::int64_t y, const Maze_v10::WallFlags wall)
+    {
+        const std::int64_t chunk_x = floor_div(x);
+        const std::int64_t chunk_y = floor_div(y);
+        const Maze_v10::Coordinates coords{static_cast<int>(x - chunk_x * chunk_size_), static_cast<int>(y - chunk_y * chunk_size_)};
+
+        return chunk(static_cast<int>(chunk_x), static_cast<int>(chunk_y)).has_wall(coords, wall);
+    }
+
+private:
+    struct Chunk {
+        Chunk(const std::uint64_t k, const int size) : key{k}, maze{size, size, 0} {}
+
+        std::uint64_t key;
+        Maze_v10 maze;
+    };
+
+    enum class Salt : std::uint64_t { Maze = 0, EastDoor = 1, SouthDoor = 2 };
+
+    const int chunk_size_;
+    const std::uint64_t world_seed_;
+    const std::size_t cache_capacity_;
+
+    std::list<Chunk> chunks_;
+    std::unordered_map<std::uint64_t, std::list<Chunk>::iterator> chunk_index_;
+    std::vector<StackNode_v6> stack_;
+
+    static std::uint64_t chunk_key(const int chunk_x, const int chunk_y) { return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunk_x)) << 32) | static_cast<std::uint32_t>(chunk_y); }
+
+    std::int64_t floor_div(const std::int64_t v) const { return (v >= 0 ? v : v - (chunk_size_ - 1)) / chunk_size_; }
+
+    std::uint64_t chunk_seed(const int chunk_x, const int chunk_y, const Salt salt) const
+    {
+        return mix_seed(world_seed_ ^ mix_seed(chunk_key(chunk_x, chunk_y) ^ mix_seed(static_cast<std::uint64_t>(salt))));
+    }
+
+    int door_position(const int chunk_x, const int chunk_y, const Salt salt) const
+    {
+        return static_cast<int>(chunk_seed(chunk_x, chunk_y, salt) % static_cast<std::uint64_t>(chunk_size_));
+    }
+
+    void generate_chunk(Maze_v10& maze, const int chunk_x, const int chunk_y)
+    {
+        maze.reset(static_cast<std::mt19937::result_type>(chunk_seed(chunk_x, chunk_y, Salt::Maze)));
+        generate_v8(maze, {0, 0}, stack_);
+
+        const int last = chunk_size_ - 1;
+        maze.clear_wall({last, door_position(chunk_x, chunk_y, Salt::EastDoor)}, Maze_v10::WallFlags::East);
+        maze.clear_wall({0, door_position(chunk_x - 1, chunk_y, Salt::EastDoor)}, Maze_v10::WallFlags::West);
+        maze.clear_wall({door_position(chunk_x, chunk_y, Salt::SouthDoor), last}, Maze_v10::WallFlags::South);
+        maze.clear_wall({door_position(chunk_x, chunk_y - 1, Salt::SouthDoor), 0}, Maze_v10::WallFlags::North);
+    }
+};
+
+struct MazeSolution {
+    std::vector<Maze_v9::Coordinates> path;
+    std::size_t visited_cells;
+};
+
+class BFSSolver {
+public:
+    void prepare(Maze_v9& maze)
+    {
+        width_ = maze.width();
+        height_ = maze.height();
+        words_per_row_ = (width_ + 63) / 64;
+
+        const std::size_t words = static_cast<std::size_t>(words_per_row_ * height_);
+        open_east_.assign(words, 0);
+        open_west_.assign(words, 0);
+        open_south_.assign(words, 0);
+        open_north_.assign(words, 0);
+        visited_.resize(words);
+        frontier_.assign(words, 0);
+        next_.resize(words);
+        distance_.resize(static_cast<std::size_t>(width_ * height_));
+        row_queued_.assign(static_cast<std::size_t>(height_), 0);
+
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                const std::size_t word = word_index(x, y);
+                const std::uint64_t bit = std::uint64_t{1} << (x % 64);
+
+                if (!maze.has_wall({x, y}, Maze_v9::WallFlags::East))
+                    open_east_[word] |= bit;
+                if (!maze.has_wall({x, y}, Maze_v9::WallFlags::West))
+                    open_west_[word] |= bit;
+                if (!maze.has_wall({x, y}, Maze_v9::WallFlags::South))
+                    open_south_[word] |= bit;
+                if (!maze.has_wall({x, y}, Maze_v9::WallFlags::North))
+                    open_north_[word] |= bit;
+            }
+        }
+    }
+
+    // distance_ is only valid where the visited_ bit is set, so it never needs to be reset.
+    const MazeSolution& solve(const Maze_v9::Coordinates start, const Maze_v9::Coordinates goal)
+    {
+        std::fill(visited_.begin(), visited_.end(), 0);
+
+        visited_[word_index(start.x, start.y)] |= cell_bit(start.x);
+        frontier_[word_index(start.x, start.y)] |= cell_bit(start.x);
+        distance_[cell_index(start)] = 0;
+
+        solution_.visited_cells = 1;
+        rows_.assign(1, start.y);
+
+        for (int dist = 1; !rows_.empty() && !is_visited(goal); ++dist) {
+            next_rows_.clear();
+
+            for (const int y : rows_) {
+                for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, height_ - 1); ++ny) {
+                    if (!row_queued_[static_cast<std::size_t>(ny)]) {
+                        row_queued_[static_cast<std::size_t>(ny)] = 1;
+                        next_rows_.push_back(ny);
+                    }
+                }
+            }
+
+            for (const int y : next_rows_)
+                expand_row(y);
+
+            for (const int y : rows_)
+                std::fill_n(frontier_.begin() + static_cast<std::ptrdiff_t>(word_index(0, y)), words_per_row_, 0);
+
+            rows_.clear();
+
+            for (const int y : next_rows_) {
+                row_queued_[static_cast<std::size_t>(y)] = 0;
+                bool row_active = false;
+
+                for (int i = 0; i < words_per_row_; ++i) {
+                    const std::size_t word = word_index(0, y) + static_cast<std::size_t>(i);
+                    std::uint64_t bits = next_[word];
+
+                    frontier_[word] = bits;
+                    visited_[word] |= bits;
+                    row_active |= bits != 0;
+                    solution_.visited_cells += static_cast<std::size_t>(std::popcount(bits));
+
+                    for (; bits; bits &= bits - 1)
+                        distance_[cell_index({i * 64 + std::countr_zero(bits), y})] = dist;
+                }
+
+                if (row_active)
+                    rows_.push_back(y);
+            }
+        }
+
+        for (const int y : rows_)
+            std::fill_n(frontier_.begin() + static_cast<std::ptrdiff_t>(word_index(0, y)), words_per_row_, 0);
+
+        solution_.path.clear();
+
+        if (is_visited(goal)) {
+            Maze_v9::Coordinates coords{goal};
+            solution_.path.push_back(coords);
+
+            for (int dist = distance_[cell_index(goal)]; dist > 0; --dist) {
+                const std::size_t word = word_index(coords.x, coords.y);
+                const std::uint64_t bit = cell_bit(coords.x);
+
+                if ((open_north_[word] & bit) && is_reached_at({coords.x, coords.y - 1}, dist - 1))
+                    --coords.y;
+                else if ((open_east_[word] & bit) && is_reached_at({coords.x + 1, coords.y}, dist - 1))
+                    ++coords.x;
+                else if ((open_south_[word] & bit) && is_reached_at({coords.x, coords.y + 1}, dist - 1))
+                    ++coords.y;
+                else if ((open_west_[word] & bit) && is_reached_at({coords.x - 1, coords.y}, dist - 1))
+                    --coords.x;
+
+                solution_.path.push_back(coords);
+            }
+
+            std::reverse(solution_.path.begin(), solution_.path.end());
+        }
+
+        return solution_;
+    }
+
+private:
+    int width_ = 0;
+    int height_ = 0;
+    int words_per_row_ = 0;
+
+    std::vector<std::uint64_t> open_east_;
+    std::vector<std::uint64_t> open_west_;
+    std::vector<std::uint64_t> open_south_;
+    std::vector<std::uint64_t> open_north_;
+    std::vector<std::uint64_t> visited_;
+    std::vector<std::uint64_t> frontier_;
+    std::vector<std::uint64_t> next_;
+    std::vector<int> distance_;
+    std::vector<int> rows_;
+    std::vector<int> next_rows_;
+    std::vector<unsigned char> row_queued_;
+
+    MazeSolution solution_;
+
+    std::size_t word_index(const int x, const int y) const { return static_cast<std::size_t>(y * words_per_row_ + x / 64); }
+    std::size_t cell_index(const Maze_v9::Coordinates coords) const { return static_cast<std::size_t>(coords.y * width_ + coords.x); }
+    static std::uint64_t cell_bit(const int x) { return std::uint64_t{1} << (x % 64); }
+
+    bool is_visited(const Maze_v9::Coordinates coords) const { return visited_[word_index(coords.x, coords.y)] & cell_bit(coords.x); }
+    bool is_reached_at(const Maze_v9::Coordinates coords, const int dist) const { return is_visited(coords) && distance_[cell_index(coords)] == dist; }
+
+    void expand_row(const int y)
+    {
+        const std::size_t row = word_index(0, y);
+
+        for (std::size_t i = 0; i < static_cast<std::size_t>(words_per_row_); ++i) {
+            const std::size_t word = row + i;
+            std::uint64_t bits = (frontier_[word] & open_east_[word]) << 1 | (frontier_[word] & open_west_[word]) >> 1;
+
+            if (i > 0)
+                bits |= (frontier_[word - 1] & open_east_[word - 1]) >> 63;
+            if (i + 1 < static_cast<std::size_t>(words_per_row_))
+                bits |= (frontier_[word + 1] & open_west_[word + 1]) << 63;
+            if (y > 0)
+                bits |= frontier_[word - static_cast<std::size_t>(words_per_row_)] & open_south_[word - static_cast<std::size_t>(words_per_row_)];
+            if (y < height_ - 1)
+                bits |= frontier_[word + static_cast<std::size_t>(words_per_row_)] & open_north_[word + static_cast<std::size_t>(words_per_row_)];
+
+            next_[word] = bits & ~visited_[word];
+        }
+    }
+};
+
+class AStarSolver {
+public:
+    const MazeSolution& solve(Maze_v9& maze, const Maze_v9::Coordinates start, const Maze_v9::Coordinates goal)
+    {
+        width_ = maze.width();
+
+        g_score_.assign(static_cast<std::size_t>(maze.width() * maze.height()), std::numeric_limits<int>::max());
+        parent_direction_.resize(static_cast<std::size_t>(maze.width() * maze.height()));
+        open_set_.clear();
+
+        g_score_[cell_index(start)] = 0;
+        push({heuristic(start, goal), 0, start});
+
+        solution_.visited_cells = 0;
+        bool found = false;
+
+        while (!open_set_.empty()) {
+            std::pop_heap(open_set_.begin(), open_set_.end(), compare);
+            const OpenNode current{open_set_.back()};
+            open_set_.pop_back();
+
+            if (current.g > g_score_[cell_index(current.coords)])
+                continue;
+
+            ++solution_.visited_cells;
+
+            if (current.coords.x == goal.x && current.coords.y == goal.y) {
+                found = true;
+                break;
+            }
+
+            for (const auto dir : {Maze_v9::Directions::North, Maze_v9::Directions::East, Maze_v9::Directions::South, Maze_v9::Directions::West}) {
+                if (maze.has_wall(current.coords, maze.wall_in_direction(dir)))
+                    continue;
+
+                const Maze_v9::Coordinates next_coords{maze.coords_in_direction(current.coords, dir)};
+                const int g = current.g + 1;
+
+                if (g < g_score_[cell_index(next_coords)]) {
+                    g_score_[cell_index(next_coords)] = g;
+                    parent_direction_[cell_index(next_coords)] = maze.opposite_direction(dir);
+                    push({g + heuristic(next_coords, goal), g, next_coords});
+                }
+            }
+        }
+
+        solution_.path.clear();
+
+        if (found) {
+            Maze_v9::Coordinates coords{goal};
+            solution_.path.push_back(coords);
+
+            while (coords.x != start.x || coords.y != start.y) {
+                coords = maze.coords_in_direction(coords, parent_direction_[cell_index(coords)]);
+                solution_.path.push_back(coords);
+            }
+
+            std::reverse(solution_.path.begin(), solution_.path.end());
+        }
+
+        return solution_;
+    }
+
+private:
+    struct OpenNode {
+        int f, g;
+        Maze_v9::Coordinates coords;
+    };
+
+    int width_ = 0;
+
+    std::vector<OpenNode> open_set_;
+    std::vector<int> g_score_;
+    std::vector<Maze_v9::Directions> parent_direction_;
+
+    MazeSolution solution_;
+
+    static bool compare(const OpenNode& a, const OpenNode& b) { return a.f > b.f || (a.f == b.f && a.g < b.g); }
+    static int heuristic(const Maze_v9::Coordinates a, const Maze_v9::Coordinates b) { return std::abs(a.x - b.x) + std::abs(a.y - b.y); }
+
+    std::size_t cell_index(const Maze_v9::Coordinates coords) const { return static_cast<std::size_t>(coords.y * width_ + coords.x); }
+
+    void push(const OpenNode node)
+    {
+        open_set_.push_back(node);
+        std::push_heap(open_set_.begin(), open_set_.end(), compare);
+    }
+};
+
+class DeadEndFillingSolver {
+public:
+    const MazeSolution& solve(Maze_v9& maze, const Maze_v9::Coordinates start, const Maze_v9::Coordinates goal)
+    {
+        width_ = maze.width();
+
+        degree_.assign(static_cast<std::size_t>(maze.width() * maze.height()), 0);
+        filled_.assign(static_cast<std::size_t>(maze.width() * maze.height()), 0);
+        queue_.clear();
+
+        for (int y = 0; y < maze.height(); ++y) {
+            for (int x = 0; x < maze.width(); ++x) {
+                const Maze_v9::Coordinates coords{x, y};
+                unsigned char degree = 0;
+
+                for (const auto dir : {Maze_v9::Directions::North, Maze_v9::Directions::East, Maze_v9::Directions::South, Maze_v9::Directions::West})
+                    if (!maze.has_wall(coords, maze.wall_in_direction(dir)))
+                        ++degree;
+
+                degree_[cell_index(coords)] = degree;
+
+                if (degree <= 1 && !is_endpoint(coords, start, goal))
+                    queue_.push_back(coords);
             }
         }
-    }
-}
 
-void visit_v4(Maze_v4& maze, const Maze_v4::Coordinates coords)
-{
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::vector<Maze_v4::Directions> directions{Maze_v4::Directions::North, Maze_v4::Directions::East, Maze_v4::Directions::South, Maze_v4::Directions::West};
-    std::shuffle(directions.begin(), directions.end(), g);
+        solution_.visited_cells = 0;
 
-    maze.set_node_visited(coords);
+        while (!queue_.empty()) {
+            const Maze_v9::Coordinates coords{queue_.back()};
+            queue_.pop_back();
 
-    for (const auto dir : directions) {
-        Maze_v4::Coordinates new_coords{maze.coords_in_direction(coords, dir)};
+            filled_[cell_index(coords)] = 1;
+            ++solution_.visited_cells;
 
-        if (maze.valid_coords(new_coords)) {
-            if (!maze.node_visited(new_coords)) {
-                maze.clear_walls(coords, new_coords, dir);
-                visit_v4(maze, new_coords);
+            for (const auto dir : {Maze_v9::Directions::North, Maze_v9::Directions::East, Maze_v9::Directions::South, Maze_v9::Directions::West}) {
+                if (maze.has_wall(coords, maze.wall_in_direction(dir)))
+                    continue;
+
+                const Maze_v9::Coordinates next_coords{maze.coords_in_direction(coords, dir)};
+
+                if (!filled_[cell_index(next_coords)] && --degree_[cell_index(next_coords)] == 1 && !is_endpoint(next_coords, start, goal))
+                    queue_.push_back(next_coords);
             }
         }
-    }
-}
 
-void visit_v5(Maze_v5& maze, const Maze_v5::Coordinates coords)
-{
-    maze.set_node_visited(coords);
+        solution_.path.clear();
+        solution_.path.push_back(start);
 
-    for (const auto dir : maze.random_directions()) {
-        Maze_v5::Coordinates new_coords{maze.coords_in_direction(coords, dir)};
+        Maze_v9::Coordinates coords{start};
+        Maze_v9::Coordinates prev_coords{-1, -1};
 
-        if (maze.valid_coords(new_coords)) {
-            if (!maze.node_visited(new_coords)) {
-                maze.clear_walls(coords, new_coords, dir);
-                visit_v5(maze, new_coords);
+        while (coords.x != goal.x || coords.y != goal.y) {
+            bool moved = false;
+
+            for (const auto dir : {Maze_v9::Directions::North, Maze_v9::Directions::East, Maze_v9::Directions::South, Maze_v9::Directions::West}) {
+                if (maze.has_wall(coords, maze.wall_in_direction(dir)))
+                    continue;
+
+                const Maze_v9::Coordinates next_coords{maze.coords_in_direction(coords, dir)};
+
+                if (!filled_[cell_index(next_coords)] && (next_coords.x != prev_coords.x || next_coords.y != prev_coords.y)) {
+                    prev_coords = coords;
+                    coords = next_coords;
+                    moved = true;
+                    break;
+                }
+            }
+
+            if (!moved) {
+                solution_.path.clear();
+                break;
             }
+
+            solution_.path.push_back(coords);
         }
+
+        solution_.visited_cells += solution_.path.size();
+
+        return solution_;
     }
-}
 
-void visit_v6(Maze_v6& maze, const Maze_v6::Coordinates coords)
+private:
+    int width_ = 0;
+
+    std::vector<unsigned char> degree_;
+    std::vector<unsigned char> filled_;
+    std::vector<Maze_v9::Coordinates> queue_;
+
+    MazeSolution solution_;
+
+    std::size_t cell_index(const Maze_v9::Coordinates coords) const { return static_cast<std::size_t>(coords.y * width_ + coords.x); }
+
+    static bool is_endpoint(const Maze_v9::Coordinates coords, const Maze_v9::Coordinates start, const Maze_v9::Coordinates goal)
+    {
+        return (coords.x == start.x && coords.y == start.y) || (coords.x == goal.x && coords.y == goal.y);
+    }
+};
+
+template <int Width, int Height>
+constexpr void generate_v10(Maze_v12<Width, Height>& maze, const typename Maze_v12<Width, Height>::Coordinates starting_point, ConstexprRandom& random)
 {
-    maze.set_node_visited(coords);
+    using Maze = Maze_v12<Width, Height>;
 
-    for (const auto dir : maze.random_directions()) {
-        Maze_v6::Coordinates new_coords{maze.coords_in_direction(coords, dir)};
+    struct StackNode {
+        int idx;
+        int permutation;
+        int rnd_idx;
+    };
 
-        if (maze.valid_coords(new_coords)) {
-            if (!maze.node_visited(new_coords)) {
-                maze.clear_walls(coords, new_coords, dir);
-                visit_v6(maze, new_coords);
+    std::array<StackNode, static_cast<std::size_t>(Width * Height)> stack{};
+    std::size_t stack_size = 0;
+
+    maze.set_node_visited(Maze::index(starting_point));
+    stack[stack_size++] = {Maze::index(starting_point), random.below(24), 0};
+
+    while (stack_size > 0) {
+        StackNode& current_node = stack[stack_size - 1];
+
+        if (current_node.rnd_idx < 4) {
+            const typename Maze::Directions* check_directions = Maze::directions(current_node.permutation);
+            bool keep_checking = true;
+
+            while (keep_checking && current_node.rnd_idx < 4) {
+                const auto dir = check_directions[current_node.rnd_idx];
+                ++current_node.rnd_idx;
+
+                if (Maze::has_neighbour(current_node.idx, dir)) {
+                    const int next_idx = Maze::index_in_direction(current_node.idx, dir);
+
+                    if (!maze.node_visited(next_idx)) {
+                        maze.clear_walls(current_node.idx, next_idx, dir);
+                        maze.set_node_visited(next_idx);
+
+                        stack[stack_size++] = {next_idx, random.below(24), 0};
+                        keep_checking = false;
+                    }
+                }
             }
+        } else {
+            --stack_size;
         }
     }
 }
 
-void visit_v7(Maze_v7& maze, const Maze_v7::Coordinates coords)
+template <int Width, int Height>
+constexpr Maze_v12<Width, Height> make_maze_v12(const std::uint64_t seed)
 {
-    maze.set_node_visited(coords);
+    Maze_v12<Width, Height> maze;
+    ConstexprRandom random{seed};
+    generate_v10(maze, {0, 0}, random);
+    return maze;
+}
 
-    for (const auto dir : maze.random_directions()) {
-        Maze_v7::Coordinates next_coords{maze.coords_in_direction(coords, dir)};
+template <int Size>
+constexpr Maze_v12<Size, Size> prebaked_maze_v12 = make_maze_v12<Size, Size>(Size);
 
-        if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
-            maze.clear_walls(coords, next_coords, dir);
-            visit_v7(maze, next_coords);
+void generate_v11(Maze_v13& maze, const Maze_v13::Coordinates starting_point)
+{
+    std::vector<StackNode_v8> stack;
+
+    maze.set_node_visited(maze.index(starting_point));
+    stack.push_back({maze.index(starting_point), maze.random_directions_index()});
+
+    while (!stack.empty()) {
+        const StackNode_v8 current_node{stack.back()};
+        const unsigned int unvisited = maze.unvisited_neighbours(current_node.idx);
+
+        if (unvisited) {
+            const auto dir = maze.next_direction(current_node.permutation, unvisited);
+            const int next_idx = maze.index_in_direction(current_node.idx, dir);
+
+            maze.clear_walls(current_node.idx, next_idx, dir);
+            maze.set_node_visited(next_idx);
+
+            stack.push_back({next_idx, maze.random_directions_index()});
+        } else {
+            stack.pop_back();
         }
     }
 }
 
-void generate_v1(Maze_v7& maze, const Maze_v7::Coordinates starting_point)
+std::size_t generate_v12(Maze_v9& maze, const Maze_v9::Coordinates starting_point)
 {
-    std::stack<StackNode_v1> stack;
+    const int width = maze.width();
+    const int height = maze.height();
+    const std::size_t words_per_row = static_cast<std::size_t>((width + 63) / 64);
+    const std::uint64_t last_word_mask = (width % 64) ? (std::uint64_t{1} << (width % 64)) - 1 : ~std::uint64_t{0};
 
-    auto rd{maze.random_directions()};
-    stack.push({starting_point, rd});
+    std::vector<std::uint64_t> unvisited(words_per_row * static_cast<std::size_t>(height), ~std::uint64_t{0});
 
-    while (!stack.empty()) {
-        StackNode_v1& current_node = stack.top();
-        maze.set_node_visited(current_node.coords);
+    for (std::size_t y = 0; y < static_cast<std::size_t>(height); ++y)
+        unvisited[y * words_per_row + words_per_row - 1] = last_word_mask;
 
-        if (!current_node.check_directions.empty()) {
-            auto dir = current_node.check_directions.back();
-            current_node.check_directions.pop_back();
+    const auto word_index = [&](const int x, const int y) { return static_cast<std::size_t>(y) * words_per_row + static_cast<std::size_t>(x / 64); };
+    const auto is_unvisited = [&](const Maze_v9::Coordinates c) { return (unvisited[word_index(c.x, c.y)] >> (c.x % 64)) & 1; };
+    const auto set_visited = [&](const Maze_v9::Coordinates c) { unvisited[word_index(c.x, c.y)] &= ~(std::uint64_t{1} << (c.x % 64)); };
+    const auto visited_word = [&](const std::size_t y, const std::size_t i) { return ~unvisited[y * words_per_row + i] & (i + 1 == words_per_row ? last_word_mask : ~std::uint64_t{0}); };
 
-            Maze_v7::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
+    Maze_v9::Coordinates coords{starting_point};
+    set_visited(coords);
 
-            if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
-                maze.clear_walls(current_node.coords, next_coords, dir);
-                maze.set_node_visited(next_coords);
+    std::size_t hunt_row = 0;
 
-                auto rd2{maze.random_directions()};
-                stack.push({next_coords, rd2});
+    while (true) {
+        bool moved = false;
+        const Maze_v9::Directions* check_directions = maze.random_directions();
+
+        for (int i = 0; i < 4 && !moved; ++i) {
+            const Maze_v9::Coordinates next_coords{maze.coords_in_direction(coords, check_directions[i])};
+
+            if (maze.valid_coords(next_coords) && is_unvisited(next_coords)) {
+                maze.clear_walls(coords, next_coords, check_directions[i]);
+                set_visited(next_coords);
+                coords = next_coords;
+                moved = true;
+            }
+        }
+
+        if (moved)
+            continue;
+
+        while (hunt_row < static_cast<std::size_t>(height) && std::all_of(unvisited.begin() + static_cast<std::ptrdiff_t>(hunt_row * words_per_row), unvisited.begin() + static_cast<std::ptrdiff_t>((hunt_row + 1) * words_per_row), [](const std::uint64_t w) { return w == 0; }))
+            ++hunt_row;
+
+        bool found = false;
+
+        for (std::size_t y = hunt_row; y < static_cast<std::size_t>(height) && !found; ++y) {
+            for (std::size_t i = 0; i < words_per_row && !found; ++i) {
+                const std::uint64_t candidates = unvisited[y * words_per_row + i];
+
+                if (!candidates)
+                    continue;
+
+                const std::uint64_t visited = visited_word(y, i);
+                std::uint64_t next_to_visited = (visited << 1) | (visited >> 1);
+
+                if (i > 0)
+                    next_to_visited |= visited_word(y, i - 1) >> 63;
+                if (i + 1 < words_per_row)
+                    next_to_visited |= visited_word(y, i + 1) << 63;
+                if (y > 0)
+                    next_to_visited |= visited_word(y - 1, i);
+                if (y + 1 < static_cast<std::size_t>(height))
+                    next_to_visited |= visited_word(y + 1, i);
+
+                if (candidates & next_to_visited) {
+                    coords = {static_cast<int>(i) * 64 + std::countr_zero(candidates & next_to_visited), static_cast<int>(y)};
+                    found = true;
+                }
+            }
+        }
+
+        if (!found)
+            break;
+
+        check_directions = maze.random_directions();
+
+        for (int i = 0; i < 4; ++i) {
+            const Maze_v9::Coordinates next_coords{maze.coords_in_direction(coords, check_directions[i])};
+
+            if (maze.valid_coords(next_coords) && !is_unvisited(next_coords)) {
+                maze.clear_walls(coords, next_coords, check_directions[i]);
+                break;
             }
-        } else {
-            stack.pop();
         }
+
+        set_visited(coords);
     }
+
+    return unvisited.size() * sizeof(std::uint64_t);
 }
 
-void generate_v2(Maze_v7& maze, const Maze_v7::Coordinates starting_point)
+template <typename Topology>
+void generate_v13(Maze_v14<Topology>& maze, const typename Topology::Coordinates starting_point)
 {
-    std::stack<StackNode_v1> stack;
+    std::vector<StackNode_v9<Topology>> stack;
 
     maze.set_node_visited(starting_point);
-    stack.push({starting_point, maze.random_directions()});
+    stack.emplace_back(starting_point, maze.random_directions());
 
     while (!stack.empty()) {
-        StackNode_v1& current_node = stack.top();
+        StackNode_v9<Topology>& current_node = stack.back();
 
-        if (!current_node.check_directions.empty()) {
+        if (current_node.rnd_idx < Topology::num_directions) {
             bool keep_checking = true;
 
-            while (keep_checking && !current_node.check_directions.empty()) {
-                const auto dir = current_node.check_directions.back();
-                current_node.check_directions.pop_back();
+            while (keep_checking && current_node.rnd_idx < Topology::num_directions) {
+                const int dir = current_node.check_directions[current_node.rnd_idx];
+                ++current_node.rnd_idx;
 
-                Maze_v7::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
+                const typename Topology::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
 
                 if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
                     maze.clear_walls(current_node.coords, next_coords, dir);
                     maze.set_node_visited(next_coords);
 
-                    stack.push({next_coords, maze.random_directions()});
+                    stack.emplace_back(next_coords, maze.random_directions());
                     keep_checking = false;
                 }
             }
         } else {
-            stack.pop();
+            stack.pop_back();
         }
     }
 }
 
-void generate_v3(Maze_v8& maze, const Maze_v8::Coordinates starting_point)
+struct MazeFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t width;
+    std::uint32_t height;
+};
+
+constexpr MazeFileHeader maze_file_header_v1{{'M', 'A', 'Z', 'E'}, 1, 0, 0};
+constexpr unsigned char maze_file_east_wall = 0b01;
+constexpr unsigned char maze_file_south_wall = 0b10;
+
+std::size_t maze_file_size(const int width, const int height)
 {
-    std::stack<StackNode_v2> stack;
+    return sizeof(MazeFileHeader) + (static_cast<std::size_t>(width) * static_cast<std::size_t>(height) + 3) / 4;
+}
 
-    maze.set_node_visited(starting_point);
-    stack.push({starting_point, maze.random_directions(), 0});
+void write_maze_file(Maze_v9& maze, const std::filesystem::path& filename)
+{
+    std::ofstream out(filename, std::ios::binary);
 
-    while (!stack.empty()) {
-        StackNode_v2& current_node = stack.top();
+    if (!out)
+        throw std::runtime_error{"unable to create maze file"};
 
-        if (current_node.rnd_idx < 4) {
-            bool keep_checking = true;
+    MazeFileHeader header{maze_file_header_v1};
+    header.width = static_cast<std::uint32_t>(maze.width());
+    header.height = static_cast<std::uint32_t>(maze.height());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
 
-            while (keep_checking && current_node.rnd_idx < 4) {
-                const auto dir = current_node.check_directions->at(static_cast<std::size_t>(current_node.rnd_idx));
-                ++current_node.rnd_idx;
+    std::vector<char> buffer;
+    buffer.reserve(1 << 20);
 
-                Maze_v8::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
+    unsigned char byte = 0;
+    int cells_in_byte = 0;
 
-                if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
-                    maze.clear_walls(current_node.coords, next_coords, dir);
-                    maze.set_node_visited(next_coords);
+    for (int y = 0; y < maze.height(); ++y) {
+        for (int x = 0; x < maze.width(); ++x) {
+            unsigned char walls = 0;
 
-                    stack.push({next_coords, maze.random_directions(), 0});
-                    keep_checking = false;
+            if (maze.has_wall({x, y}, Maze_v9::WallFlags::East))
+                walls |= maze_file_east_wall;
+            if (maze.has_wall({x, y}, Maze_v9::WallFlags::South))
+                walls |= maze_file_south_wall;
+
+            byte = static_cast<unsigned char>(byte | (walls << (2 * cells_in_byte)));
+
+            if (++cells_in_byte == 4) {
+                buffer.push_back(static_cast<char>(byte));
+                byte = 0;
+                cells_in_byte = 0;
+
+                if (buffer.size() == buffer.capacity()) {
+                    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    buffer.clear();
                 }
             }
-        } else {
-            stack.pop();
         }
     }
+
+    if (cells_in_byte > 0)
+        buffer.push_back(static_cast<char>(byte));
+
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+    if (!out)
+        throw std::runtime_error{"unable to write maze file"};
 }
 
-void generate_v4(Maze_v8& maze, const Maze_v8::Coordinates starting_point)
+class MappedMaze {
+public:
+    explicit MappedMaze(const std::filesystem::path& filename)
+    {
+#ifdef _WIN32
+        std::ifstream in(filename, std::ios::binary);
+
+        if (!in)
+            throw std::runtime_error{"unable to open maze file"};
+
+        buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data_ = reinterpret_cast<const unsigned char*>(buffer_.data());
+        size_ = buffer_.size();
+#else
+        const int fd = open(filename.c_str(), O_RDONLY);
+
+        if (fd < 0)
+            throw std::runtime_error{"unable to open maze file"};
+
+        struct stat st;
+
+        if (fstat(fd, &st) < 0) {
+            close(fd);
+            throw std::runtime_error{"unable to stat maze file"};
+        }
+
+        size_ = static_cast<std::size_t>(st.st_size);
+        void* data = size_ > 0 ? mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        close(fd);
+
+        if (data == MAP_FAILED)
+            throw std::runtime_error{"unable to map maze file"};
+
+        data_ = static_cast<const unsigned char*>(data);
+#endif
+
+        MazeFileHeader header;
+
+        if (size_ < sizeof(header)) {
+            unmap();
+            throw std::runtime_error{"maze file too small"};
+        }
+
+        std::copy_n(data_, sizeof(header), reinterpret_cast<unsigned char*>(&header));
+
+        if (!std::equal(std::begin(header.magic), std::end(header.magic), std::begin(maze_file_header_v1.magic)) || header.version != maze_file_header_v1.version) {
+            unmap();
+            throw std::runtime_error{"unknown maze file format"};
+        }
+
+        constexpr auto max_dimension = static_cast<std::uint32_t>(std::numeric_limits<int>::max());
+
+        if (header.width == 0 || header.height == 0 || header.width > max_dimension || header.height > max_dimension) {
+            unmap();
+            throw std::runtime_error{"invalid maze file dimensions"};
+        }
+
+        width_ = static_cast<int>(header.width);
+        height_ = static_cast<int>(header.height);
+
+        if (size_ != maze_file_size(width_, height_)) {
+            unmap();
+            throw std::runtime_error{"maze file size does not match its dimensions"};
+        }
+
+        walls_ = data_ + sizeof(header);
+    }
+
+    ~MappedMaze() { unmap(); }
+
+    MappedMaze(const MappedMaze&) = delete;
+    MappedMaze& operator=(const MappedMaze&) = delete;
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    bool has_wall(const Maze_v9::Coordinates coords, const Maze_v9::WallFlags wall) const
+    {
+        switch (wall) {
+        case Maze_v9::WallFlags::North:
+            return coords.y == 0 || (cell_walls(coords.x, coords.y - 1) & maze_file_south_wall);
+        case Maze_v9::WallFlags::East:
+            return cell_walls(coords.x, coords.y) & maze_file_east_wall;
+        case Maze_v9::WallFlags::South:
+            return cell_walls(coords.x, coords.y) & maze_file_south_wall;
+        case Maze_v9::WallFlags::West:
+            return coords.x == 0 || (cell_walls(coords.x - 1, coords.y) & maze_file_east_wall);
+        }
+
+        return true;
+    }
+
+private:
+    const unsigned char* data_ = nullptr;
+    const unsigned char* walls_ = nullptr;
+    std::size_t size_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+
+#ifdef _WIN32
+    std::vector<char> buffer_;
+#endif
+
+    unsigned char cell_walls(const int x, const int y) const
+    {
+        const std::size_t idx = static_cast<std::size_t>(y) * static_cast<std::size_t>(width_) + static_cast<std::size_t>(x);
+        return static_cast<unsigned char>(walls_[idx / 4] >> (2 * (idx % 4)));
+    }
+
+    void unmap()
+    {
+#ifndef _WIN32
+        if (data_)
+            munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+        data_ = nullptr;
+    }
+};
+
+void evict_from_page_cache([[maybe_unused]] const std::filesystem::path& filename)
 {
-    std::vector<StackNode_v3> stack;
+#if !defined(_WIN32) && !defined(__APPLE__)
+    const int fd = open(filename.c_str(), O_RDONLY);
 
-    maze.set_node_visited(starting_point);
-    stack.emplace_back(starting_point, maze.random_directions());
+    if (fd >= 0) {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#endif
+}
 
-    while (!stack.empty()) {
-        StackNode_v3& current_node = stack.back();
+bool is_valid_maze_file(const std::filesystem::path& filename, const int size)
+{
+    try {
+        const MappedMaze maze{filename};
+        return maze.width() == size && maze.height() == size;
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+}
+
+std::filesystem::path maze_file(const int size)
+{
+    const std::filesystem::path filename{std::filesystem::temp_directory_path() / ("maze_" + std::to_string(size) + ".maze")};
+
+    if (!std::filesystem::exists(filename) || !is_valid_maze_file(filename, size)) {
+        const std::filesystem::path temporary{filename.string() + "." + std::to_string(std::random_device{}()) + ".tmp"};
+
+        Maze_v9 maze(size, size);
+        generate_v7(maze, {0, 0});
+
+        try {
+            write_maze_file(maze, temporary);
+            std::filesystem::rename(temporary, filename);
+        } catch (...) {
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+            throw;
+        }
+    }
+
+    return filename;
+}
+
+constexpr unsigned char render_passage = 255;
+constexpr unsigned char render_wall = 0;
+
+void render_row_pair(const Maze_v9::Node* nodes, const int width, unsigned char* row_a, unsigned char* row_b)
+{
+    row_a[0] = render_wall;
+    row_b[0] = render_wall;
+
+    int x = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i east_wall = _mm_set1_epi8(static_cast<char>(Maze_v9::WallFlags::East));
+    const __m128i south_wall = _mm_set1_epi8(static_cast<char>(Maze_v9::WallFlags::South));
+    const __m128i wall = _mm_set1_epi8(static_cast<char>(render_wall));
+    const __m128i passage = _mm_set1_epi8(static_cast<char>(render_passage));
+
+    for (; x + 16 <= width; x += 16) {
+        const __m128i cells = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nodes + x));
+        const __m128i east = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi8(_mm_and_si128(cells, east_wall), east_wall), passage), wall);
+        const __m128i south = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi8(_mm_and_si128(cells, south_wall), south_wall), passage), wall);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row_a + 1 + 2 * x), _mm_unpacklo_epi8(passage, east));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row_a + 17 + 2 * x), _mm_unpackhi_epi8(passage, east));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row_b + 1 + 2 * x), _mm_unpacklo_epi8(south, wall));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row_b + 17 + 2 * x), _mm_unpackhi_epi8(south, wall));
+    }
+#endif
+
+    for (; x < width; ++x) {
+        row_a[1 + 2 * x] = render_passage;
+        row_a[2 + 2 * x] = (nodes[x] & static_cast<Maze_v9::Node>(Maze_v9::WallFlags::East)) ? render_wall : render_passage;
+        row_b[1 + 2 * x] = (nodes[x] & static_cast<Maze_v9::Node>(Maze_v9::WallFlags::South)) ? render_wall : render_passage;
+        row_b[2 + 2 * x] = render_wall;
+    }
+}
+
+void pack_row_1bit(const unsigned char* pixels, const int width, unsigned char* bits)
+{
+    const int full_bytes = width / 8;
+    int i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+    static constexpr auto reversed_bits = [] {
+        std::array<unsigned char, 256> table{};
+
+        for (unsigned int byte = 0; byte < 256; ++byte)
+            for (unsigned int bit = 0; bit < 8; ++bit)
+                if (byte & (1u << bit))
+                    table[byte] = static_cast<unsigned char>(table[byte] | (0x80u >> bit));
+
+        return table;
+    }();
+
+    const __m128i wall = _mm_set1_epi8(static_cast<char>(render_wall));
+
+    for (; i + 2 <= full_bytes; i += 2) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 8 * i));
+        const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, wall)));
+
+        bits[i] = reversed_bits[mask & 0xff];
+        bits[i + 1] = reversed_bits[mask >> 8];
+    }
+#endif
+
+    for (; i < full_bytes; ++i) {
+        unsigned int byte = 0;
+
+        for (int k = 0; k < 8; ++k)
+            byte = (byte << 1) | (pixels[8 * i + k] == render_wall);
+
+        bits[i] = static_cast<unsigned char>(byte);
+    }
+
+    if (width % 8) {
+        unsigned int byte = 0;
 
-        if (current_node.rnd_idx < 4) {
-            bool keep_checking = true;
+        for (int k = 0; k < 8; ++k)
+            byte = (byte << 1) | (8 * full_bytes + k < width && pixels[8 * full_bytes + k] == render_wall);
 
-            while (keep_checking && current_node.rnd_idx < 4) {
-                const auto dir = current_node.check_directions->at(static_cast<std::size_t>(current_node.rnd_idx));
-                ++current_node.rnd_idx;
+        bits[full_bytes] = static_cast<unsigned char>(byte);
+    }
+}
 
-                Maze_v8::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
+void render_maze_8bit(Maze_v9& maze, std::vector<unsigned char>& image)
+{
+    const std::size_t image_width = static_cast<std::size_t>(2 * maze.width() + 1);
+    image.resize(image_width * static_cast<std::size_t>(2 * maze.height() + 1));
 
-                if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
-                    maze.clear_walls(current_node.coords, next_coords, dir);
-                    maze.set_node_visited(next_coords);
+    std::fill_n(image.begin(), image_width, render_wall);
 
-                    stack.emplace_back(next_coords, maze.random_directions());
-                    keep_checking = false;
-                }
-            }
-        } else {
-            stack.pop_back();
-        }
+    for (int y = 0; y < maze.height(); ++y) {
+        unsigned char* row_a = image.data() + static_cast<std::size_t>(2 * y + 1) * image_width;
+        render_row_pair(&maze.node({0, y}), maze.width(), row_a, row_a + image_width);
     }
 }
 
-void generate_v5(Maze_v9& maze, const Maze_v9::Coordinates starting_point)
+void render_maze_1bit(Maze_v9& maze, std::vector<unsigned char>& image)
 {
-    std::vector<StackNode_v4> stack;
+    const int image_width = 2 * maze.width() + 1;
+    const std::size_t bytes_per_row = static_cast<std::size_t>((image_width + 7) / 8);
+    image.resize(bytes_per_row * static_cast<std::size_t>(2 * maze.height() + 1));
 
-    maze.set_node_visited(starting_point);
-    stack.emplace_back(starting_point, maze.random_directions());
+    std::vector<unsigned char> row_a(static_cast<std::size_t>(image_width), render_wall);
+    std::vector<unsigned char> row_b(static_cast<std::size_t>(image_width));
 
-    while (!stack.empty()) {
-        StackNode_v4& current_node = stack.back();
+    pack_row_1bit(row_a.data(), image_width, image.data());
 
-        if (current_node.rnd_idx < 4) {
-            bool keep_checking = true;
+    for (int y = 0; y < maze.height(); ++y) {
+        render_row_pair(&maze.node({0, y}), maze.width(), row_a.data(), row_b.data());
+        pack_row_1bit(row_a.data(), image_width, image.data() + static_cast<std::size_t>(2 * y + 1) * bytes_per_row);
+        pack_row_1bit(row_b.data(), image_width, image.data() + static_cast<std::size_t>(2 * y + 2) * bytes_per_row);
+    }
+}
 
-            while (keep_checking && current_node.rnd_idx < 4) {
-                const auto dir = current_node.check_directions[current_node.rnd_idx];
-                ++current_node.rnd_idx;
+std::string render_maze_ascii(Maze_v9& maze)
+{
+    const std::size_t image_width = static_cast<std::size_t>(2 * maze.width() + 1);
+    std::vector<unsigned char> row_a(image_width);
+    std::vector<unsigned char> row_b(image_width);
 
-                Maze_v9::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
+    std::string ascii(image_width, '#');
+    ascii.reserve((image_width + 1) * static_cast<std::size_t>(2 * maze.height() + 1));
+    ascii += '\n';
 
-                if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
-                    maze.clear_walls(current_node.coords, next_coords, dir);
-                    maze.set_node_visited(next_coords);
+    for (int y = 0; y < maze.height(); ++y) {
+        render_row_pair(&maze.node({0, y}), maze.width(), row_a.data(), row_b.data());
 
-                    stack.emplace_back(next_coords, maze.random_directions());
-                    keep_checking = false;
-                }
-            }
-        } else {
-            stack.pop_back();
+        for (const auto* row : {&row_a, &row_b}) {
+            for (const auto pixel : *row)
+                ascii += pixel == render_wall ? '#' : ' ';
+
+            ascii += '\n';
         }
     }
+
+    return ascii;
 }
 
-void generate_v6(Maze_v9& maze, const Maze_v9::Coordinates starting_point)
+void render_maze_file_pgm(const MappedMaze& maze, std::ostream& out)
 {
-    std::vector<StackNode_v4> stack;
-
-    maze.set_node_visited(starting_point);
-    stack.emplace_back(starting_point, maze.random_directions());
-
-    while (!stack.empty()) {
-        StackNode_v4& current_node = stack.back();
+    const std::size_t image_width = static_cast<std::size_t>(2 * maze.width() + 1);
 
-        if (current_node.rnd_idx < 4) {
-            bool keep_checking = true;
+    std::vector<Maze_v9::Node> nodes(static_cast<std::size_t>(maze.width()));
+    std::vector<unsigned char> row_a(image_width, render_wall);
+    std::vector<unsigned char> row_b(image_width);
 
-            while (keep_checking && current_node.rnd_idx < 4) {
-                const auto dir = current_node.check_directions[current_node.rnd_idx];
-                ++current_node.rnd_idx;
+    out << "P5\n" << image_width << ' ' << 2 * maze.height() + 1 << "\n255\n";
+    out.write(reinterpret_cast<const char*>(row_a.data()), static_cast<std::streamsize>(image_width));
 
-                Maze_v9::Coordinates next_coords{maze.coords_in_direction(current_node.coords, dir)};
+    for (int y = 0; y < maze.height(); ++y) {
+        for (int x = 0; x < maze.width(); ++x) {
+            Maze_v9::Node node = 0;
 
-                if (maze.valid_coords(next_coords) && !maze.node_visited(next_coords)) {
-                    maze.clear_walls(current_node.coords, next_coords, dir);
-                    maze.set_node_visited(next_coords);
+            if (maze.has_wall({x, y}, Maze_v9::WallFlags::East))
+                node |= static_cast<Maze_v9::Node>(Maze_v9::WallFlags::East);
+            if (maze.has_wall({x, y}, Maze_v9::WallFlags::South))
+                node |= static_cast<Maze_v9::Node>(Maze_v9::WallFlags::South);
 
-                    stack.emplace_back(next_coords, maze.random_directions());
-                    keep_checking = false;
-                }
-            }
-        } else {
-            stack.pop_back();
+            nodes[static_cast<std::size_t>(x)] = node;
         }
+
+        render_row_pair(nodes.data(), maze.width(), row_a.data(), row_b.data());
+        out.write(reinterpret_cast<const char*>(row_a.data()), static_cast<std::streamsize>(image_width));
+        out.write(reinterpret_cast<const char*>(row_b.data()), static_cast<std::streamsize>(image_width));
     }
 }
 
+class NullBuffer : public std::streambuf {
+protected:
+    std::streamsize xsputn(const char*, const std::streamsize count) override { return count; }
+    int_type overflow(const int_type ch) override { return traits_type::not_eof(ch); }
+};
+
 static void BM_Visit_v1(benchmark::State& state)
 {
     constexpr int num_rows = 15;
@@ -1144,6 +3073,387 @@ static void BM_Generate_v6(benchmark::State& state)
     }
 }
 
+static void BM_Generate_v7(benchmark::State& state)
+{
+    for (auto _ : state) {
+        Maze_v9 maze(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)));
+        generate_v7(maze, {0, 0});
+        benchmark::DoNotOptimize(const_cast<const Maze_v9 &>(maze));
+    }
+
+    state.counters["stack_node_bytes"] = static_cast<double>(sizeof(StackNode_v5));
+    state.counters["stack_node_bytes_v6"] = static_cast<double>(sizeof(StackNode_v4));
+}
+
+static void BM_GenerateBatch_Fresh(benchmark::State& state)
+{
+    constexpr int batch_size = 1000;
+
+    for (auto _ : state) {
+        for (int i = 0; i < batch_size; ++i) {
+            Maze_v9 maze(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)));
+            generate_v6(maze, {0, 0});
+            benchmark::DoNotOptimize(const_cast<const Maze_v9 &>(maze));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+static void BM_GenerateBatch_Reuse(benchmark::State& state)
+{
+    constexpr int batch_size = 1000;
+    std::random_device random_device;
+    const auto seed = random_device();
+
+    MazeBatchPool batch_pool(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)), static_cast<int>(state.range(1)), seed);
+
+    for (auto _ : state)
+        batch_pool.generate(batch_size, [](const Maze_v10& maze) { benchmark::DoNotOptimize(maze); });
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+static void BM_ChunkedMaze_Generate(benchmark::State& state)
+{
+    ChunkedMaze maze(static_cast<int>(state.range(0)), 42, 64);
+    int chunk_x = 0;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(maze.chunk(chunk_x++, 0));
+
+    state.counters["cells"] = static_cast<double>(state.range(0) * state.range(0));
+}
+
+static void BM_ChunkedMaze_CacheHit(benchmark::State& state)
+{
+    constexpr int cached_chunks = 8;
+    ChunkedMaze maze(static_cast<int>(state.range(0)), 42, 64);
+    int chunk_x = 0;
+
+    for (int i = 0; i < cached_chunks; ++i)
+        maze.chunk(i, 0);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(maze.chunk(chunk_x, 0));
+        chunk_x = (chunk_x + 1) % cached_chunks;
+    }
+}
+
+template <typename Layout>
+static void BM_Generate_v9(benchmark::State& state)
+{
+    std::random_device random_device;
+
+    for (auto _ : state) {
+        Maze_v11<Layout> maze(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)), random_device());
+        generate_v9(maze, {0, 0});
+        benchmark::DoNotOptimize(const_cast<const Maze_v11<Layout> &>(maze));
+    }
+}
+
+template <typename Layout>
+static void BM_RandomWalk(benchmark::State& state)
+{
+    constexpr std::size_t steps = 1 << 22;
+    std::random_device random_device;
+    std::mt19937 random_generator(random_device());
+
+    Maze_v11<Layout> maze(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)), random_device());
+    generate_v9(maze, {0, 0});
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(random_walk(maze, steps, random_generator));
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * steps));
+}
+
+static void BM_Solve_BFS(benchmark::State& state)
+{
+    const int size = static_cast<int>(state.range(0));
+    Maze_v9 maze(size, size);
+    generate_v6(maze, {0, 0});
+
+    BFSSolver solver;
+    solver.prepare(maze);
+
+    std::size_t path_length = 0;
+    std::size_t visited_cells = 0;
+
+    for (auto _ : state) {
+        const MazeSolution& solution = solver.solve({0, 0}, {size - 1, size - 1});
+        path_length = solution.path.size();
+        visited_cells = solution.visited_cells;
+        benchmark::DoNotOptimize(solution);
+    }
+
+    state.counters["path_length"] = static_cast<double>(path_length);
+    state.counters["visited_cells"] = static_cast<double>(visited_cells);
+}
+
+static void BM_Solve_BFS_Prepare(benchmark::State& state)
+{
+    const int size = static_cast<int>(state.range(0));
+    Maze_v9 maze(size, size);
+    generate_v6(maze, {0, 0});
+
+    BFSSolver solver;
+
+    for (auto _ : state) {
+        solver.prepare(maze);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * size * size);
+}
+
+static void BM_Solve_AStar(benchmark::State& state)
+{
+    const int size = static_cast<int>(state.range(0));
+    Maze_v9 maze(size, size);
+    generate_v6(maze, {0, 0});
+
+    AStarSolver solver;
+    std::size_t path_length = 0;
+    std::size_t visited_cells = 0;
+
+    for (auto _ : state) {
+        const MazeSolution& solution = solver.solve(maze, {0, 0}, {size - 1, size - 1});
+        path_length = solution.path.size();
+        visited_cells = solution.visited_cells;
+        benchmark::DoNotOptimize(solution);
+    }
+
+    state.counters["path_length"] = static_cast<double>(path_length);
+    state.counters["visited_cells"] = static_cast<double>(visited_cells);
+}
+
+static void BM_Solve_DeadEndFilling(benchmark::State& state)
+{
+    const int size = static_cast<int>(state.range(0));
+    Maze_v9 maze(size, size);
+    generate_v6(maze, {0, 0});
+
+    DeadEndFillingSolver solver;
+    std::size_t path_length = 0;
+    std::size_t visited_cells = 0;
+
+    for (auto _ : state) {
+        const MazeSolution& solution = solver.solve(maze, {0, 0}, {size - 1, size - 1});
+        path_length = solution.path.size();
+        visited_cells = solution.visited_cells;
+        benchmark::DoNotOptimize(solution);
+    }
+
+    state.counters["path_length"] = static_cast<double>(path_length);
+    state.counters["visited_cells"] = static_cast<double>(visited_cells);
+}
+
+static void BM_Generate_v13_Square(benchmark::State& state)
+{
+    const SquareTopology topology(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        Maze_v14<SquareTopology> maze(topology);
+        generate_v13(maze, {0, 0});
+        benchmark::DoNotOptimize(const_cast<const Maze_v14<SquareTopology> &>(maze));
+    }
+
+    state.counters["cells"] = static_cast<double>(topology.size());
+}
+
+static void BM_Generate_v13_Cube(benchmark::State& state)
+{
+    const CubeTopology topology(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)), static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        Maze_v14<CubeTopology> maze(topology);
+        generate_v13(maze, {0, 0, 0});
+        benchmark::DoNotOptimize(const_cast<const Maze_v14<CubeTopology> &>(maze));
+    }
+
+    state.counters["cells"] = static_cast<double>(topology.size());
+}
+
+static void BM_Generate_v13_Hex(benchmark::State& state)
+{
+    const HexTopology topology(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        Maze_v14<HexTopology> maze(topology);
+        generate_v13(maze, {0, 0});
+        benchmark::DoNotOptimize(const_cast<const Maze_v14<HexTopology> &>(maze));
+    }
+
+    state.counters["cells"] = static_cast<double>(topology.size());
+}
+
+static void BM_Generate_v12(benchmark::State& state)
+{
+    std::size_t bitset_bytes = 0;
+
+    for (auto _ : state) {
+        Maze_v9 maze(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)));
+        bitset_bytes = generate_v12(maze, {0, 0});
+        benchmark::DoNotOptimize(const_cast<const Maze_v9 &>(maze));
+    }
+
+    state.counters["bitset_bytes"] = static_cast<double>(bitset_bytes);
+}
+
+static void BM_Generate_v11(benchmark::State& state)
+{
+    for (auto _ : state) {
+        Maze_v13 maze(static_cast<int>(state.range(0)), static_cast<int>(state.range(0)));
+        generate_v11(maze, {0, 0});
+        benchmark::DoNotOptimize(const_cast<const Maze_v13 &>(maze));
+    }
+}
+
+template <int Size>
+static void BM_Generate_v10(benchmark::State& state)
+{
+    std::random_device random_device;
+    ConstexprRandom random{random_device()};
+
+    for (auto _ : state) {
+        Maze_v12<Size, Size> maze;
+        generate_v10(maze, {0, 0}, random);
+        benchmark::DoNotOptimize(maze);
+    }
+}
+
+template <int Size>
+static void BM_Prebaked_v10(benchmark::State& state)
+{
+    for (auto _ : state) {
+        Maze_v12<Size, Size> maze{prebaked_maze_v12<Size>};
+        benchmark::DoNotOptimize(maze);
+    }
+}
+
+static double render_megapixels(const int size)
+{
+    return static_cast<double>(2 * size + 1) * static_cast<double>(2 * size + 1) / 1e6;
+}
+
+static void BM_Render_8bit(benchmark::State& state)
+{
+    const int size = static_cast<int>(state.range(0));
+    Maze_v9 maze(size, size);
+    generate_v7(maze, {0, 0});
+
+    std::vector<unsigned char> image;
+
+    for (auto _ : state) {
+        render_maze_8bit(maze, image);
+        benchmark::DoNotOptimize(image.data());
+    }
+
+    state.counters["megapixels"] = benchmark::Counter(static_cast<double>(state.iterations()) * render_megapixels(size), benchmark::Counter::kIsRate);
+}
+
+static void BM_Render_1bit(benchmark::State& state)
+{
+    const int size = static_cast<int>(state.range(0));
+    Maze_v9 maze(size, size);
+    generate_v7(maze, {0, 0});
+
+    std::vector<unsigned char> image;
+
+    for (auto _ : state) {
+        render_maze_1bit(maze, image);
+        benchmark::DoNotOptimize(image.data());
+    }
+
+    state.counters["megapixels"] = benchmark::Counter(static_cast<double>(state.iterations()) * render_megapixels(size), benchmark::Counter::kIsRate);
+}
+
+static void BM_Render_ASCII(benchmark::State& state)
+{
+    const int size = static_cast<int>(state.range(0));
+    Maze_v9 maze(size, size);
+    generate_v7(maze, {0, 0});
+
+    for (auto _ : state) {
+        const std::string ascii{render_maze_ascii(maze)};
+        benchmark::DoNotOptimize(ascii.data());
+    }
+
+    state.counters["megapixels"] = benchmark::Counter(static_cast<double>(state.iterations()) * render_megapixels(size), benchmark::Counter::kIsRate);
+}
+
+static void BM_Render_Stream(benchmark::State& state)
+{
+    const int size = static_cast<int>(state.range(0));
+    const MappedMaze maze{maze_file(size)};
+
+    NullBuffer null_buffer;
+    std::ostream out(&null_buffer);
+
+    for (auto _ : state)
+        render_maze_file_pgm(maze, out);
+
+    state.counters["megapixels"] = benchmark::Counter(static_cast<double>(state.iterations()) * render_megapixels(size), benchmark::Counter::kIsRate);
+}
+
+static void BM_MazeFile_Write(benchmark::State& state)
+{
+    const int size = static_cast<int>(state.range(0));
+    const std::filesystem::path filename{std::filesystem::temp_directory_path() / ("maze_write_" + std::to_string(size) + ".maze")};
+
+    Maze_v9 maze(size, size);
+    generate_v7(maze, {0, 0});
+
+    for (auto _ : state)
+        write_maze_file(maze, filename);
+
+    std::filesystem::remove(filename);
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(maze_file_size(size, size)));
+}
+
+static void BM_MazeFile_ColdLoad(benchmark::State& state)
+{
+    const std::filesystem::path filename{maze_file(static_cast<int>(state.range(0)))};
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        evict_from_page_cache(filename);
+        state.ResumeTiming();
+
+        const MappedMaze maze{filename};
+        benchmark::DoNotOptimize(maze.has_wall({maze.width() - 1, maze.height() - 1}, Maze_v9::WallFlags::North));
+    }
+}
+
+static void BM_MazeFile_Query(benchmark::State& state)
+{
+    constexpr int queries = 1 << 20;
+    const int size = static_cast<int>(state.range(0));
+    const MappedMaze maze{maze_file(size)};
+
+    std::random_device random_device;
+    std::mt19937 random_generator(random_device());
+    std::uniform_int_distribution<> random_coord{0, size - 1};
+
+    std::vector<Maze_v9::Coordinates> coords(queries);
+
+    for (auto& c : coords)
+        c = {random_coord(random_generator), random_coord(random_generator)};
+
+    for (auto _ : state) {
+        int walls = 0;
+
+        for (int i = 0; i < queries; ++i)
+            walls += maze.has_wall(coords[static_cast<std::size_t>(i)], static_cast<Maze_v9::WallFlags>(1 << (i & 0b11)));
+
+        benchmark::DoNotOptimize(walls);
+    }
+
+    state.SetItemsProcessed(state.iterations() * queries);
+}
+
 BENCHMARK(BM_Visit_v1)->Arg(15)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_Visit_v2)->Arg(15)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_Visit_v3)->Arg(15)->Unit(benchmark::kMicrosecond);
@@ -1184,5 +3494,83 @@ BENCHMARK(BM_Generate_v5)->Arg(50)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_Generate_v6)->Arg(15)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_Generate_v6)->Arg(25)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_Generate_v6)->Arg(50)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Generate_v6)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Generate_v6)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Generate_v7)->Arg(15)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Generate_v7)->Arg(25)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Generate_v7)->Arg(50)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Generate_v7)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Generate_v7)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_GenerateBatch_Fresh)->Arg(15)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GenerateBatch_Fresh)->Arg(50)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_GenerateBatch_Reuse)->Args({15, 1})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_GenerateBatch_Reuse)->Args({15, 4})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_GenerateBatch_Reuse)->Args({50, 1})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_GenerateBatch_Reuse)->Args({50, 4})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK(BM_ChunkedMaze_Generate)->Arg(16)->Arg(64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ChunkedMaze_CacheHit)->Arg(16)->Arg(64);
+
+BENCHMARK_TEMPLATE(BM_Generate_v9, RowMajorLayout)->Arg(1000)->Arg(4000)->Arg(16000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Generate_v9, BlockedLayout)->Arg(1000)->Arg(4000)->Arg(16000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Generate_v9, MortonLayout)->Arg(1000)->Arg(4000)->Arg(16000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_RandomWalk, RowMajorLayout)->Arg(1000)->Arg(4000)->Arg(16000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_RandomWalk, BlockedLayout)->Arg(1000)->Arg(4000)->Arg(16000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_RandomWalk, MortonLayout)->Arg(1000)->Arg(4000)->Arg(16000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Solve_BFS)->Arg(15)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Solve_BFS)->Arg(50)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Solve_BFS)->Arg(250)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Solve_BFS)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Solve_BFS_Prepare)->Arg(15)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Solve_BFS_Prepare)->Arg(50)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Solve_BFS_Prepare)->Arg(250)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Solve_BFS_Prepare)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Solve_AStar)->Arg(15)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Solve_AStar)->Arg(50)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Solve_AStar)->Arg(250)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Solve_AStar)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Solve_DeadEndFilling)->Arg(15)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Solve_DeadEndFilling)->Arg(50)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Solve_DeadEndFilling)->Arg(250)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Solve_DeadEndFilling)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Generate_v11)->Arg(50)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Generate_v11)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Generate_v11)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Generate_v12)->Arg(15)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Generate_v12)->Arg(50)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Generate_v12)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Generate_v12)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Generate_v6)->Arg(64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Generate_v13_Square)->Arg(64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Generate_v13_Square)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Generate_v13_Hex)->Arg(64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Generate_v13_Hex)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Generate_v13_Cube)->Arg(16)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Generate_v13_Cube)->Arg(100)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Generate_v10, 15)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Generate_v10, 25)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Prebaked_v10, 15)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Prebaked_v10, 25)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_MazeFile_Write)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MazeFile_ColdLoad)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MazeFile_Query)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Render_8bit)->Arg(100)->Arg(1000)->Arg(4000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Render_1bit)->Arg(100)->Arg(1000)->Arg(4000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Render_ASCII)->Arg(100)->Arg(1000)->Arg(4000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Render_Stream)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
 
 BENCHMARK_MAIN();
@@ -3,37 +3,25 @@
 
 #include <benchmark/benchmark.h>
 #include <boost/regex.hpp>
-#include <fstream>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <pcre.h>
 #include <pcre2.h>
+#include <random>
 #include <re2/re2.h>
+#include <re2/set.h>
 #include <regex>
+#include <string_view>
 
-const std::string one_line{"[00180D0F | 2009-09-15 09:34:48] (127.0.0.1:39170, 879) /cmd.php [co_search.browse] RQST END   [normal]   799 ms"};
-const std::vector<std::string> all_lines{
-    "[05821BE4 | 2019-05-13 12:28:56] (13036) http://test.site/projects/cmd.php [co_project.view] RQST START",
-    "[05821BE4 | 2019-05-13 12:28:56] (13036) http://test.site/projects/cmd.php [co_project.view] RQST END   [normal]   402 ms",
-    "[05671FA1 | 2019-04-17 14:08:03] (62931) http://test.site/projects/cmd.php [co_project.view] RQST START",
-    "[05671FA1 | 2019-04-17 14:08:03] (62931) http://test.site/projects/cmd.php [co_project.view] RQST END   [normal]   237 ms",
-    "[05822AE4 | 2019-06-17 06:59:03] (15828) http://test.site/cmd.php [co_project.dialog_doc_details] RQST START",
-    "[05822AE4 | 2019-06-17 06:59:03] (15828) http://test.site/cmd.php [co_project.dialog_doc_details] RQST END   [normal]   318 ms",
-    "[00180D0F | 2009-09-15 09:34:47] (127.0.0.1:39170, 879) /cmd.php [co_search.browse] RQST START",
-    "[00180D0F | 2009-09-15 09:34:48] (127.0.0.1:39170, 879) /cmd.php [co_search.browse] RQST END   [normal]   799 ms",
-    "[00180D0D | 2009-09-15 09:34:19] (127.0.0.1:39169, 23727) /browse/ RQST START",
-    "[00180D0D | 2009-09-15 09:34:19] (127.0.0.1:39169, 23727) /browse/ RQST END   [normal]    35 ms",
-    "[001F86EA | 2009-11-02 16:05:50] (127.0.0.1:1789, 10994) /cmd.php [co_doc.details] RQST START",
-    "[001F86EA | 2009-11-02 16:05:50] (127.0.0.1:1789, 10994) /cmd.php [co_doc.details] RQST END   [normal]    84 ms"};
-
-const char* regex1 = R"(\[(.+) \| ([^\]]+)\] \((.+, )?(\d+)\) (.+) \[(.+)\] RQST END   \[(.+)\] *(\d+) ms)";
-const char* regex2 = R"(\[([^ ]{8}) \| ([^\]]{19})\] \((?:[^,]+, )?\d+\) [^ ]+ \[([^\]]+)\] RQST END   \[[^\]]+\] *(\d+) ms)";
-const char* regex3 = R"(^\[([^ ]{8}) \| ([^\]]{19})\] \((?:[^,]+, )?\d+\) [^ ]+ \[([^\]]+)\] RQST END   \[[^\]]+\] *(\d+) ms)";
-
-std::size_t check_std_regex(const std::string& line, const std::regex& re, std::smatch& m)
+#include "compile_time_regex.h"
+#include "regex_benchmark.h"
+
+std::size_t check_std_regex(const std::string_view line, const std::regex& re, std::match_results<std::string_view::const_iterator>& m)
 {
     std::size_t length = 0;
 
-    if (std::regex_match(line, m, re))
+    if (std::regex_match(line.begin(), line.end(), m, re))
         if (m.size() > 1)
             for (int i = 1; i < static_cast<int>(m.size()); ++i)
                 length += static_cast<std::size_t>(m[static_cast<std::size_t>(i)].length());
@@ -41,11 +29,11 @@ std::size_t check_std_regex(const std::string& line, const std::regex& re, std::
     return length;
 }
 
-std::size_t check_boost_regex(const std::string& line, const boost::regex& re, boost::smatch& m)
+std::size_t check_boost_regex(const std::string_view line, const boost::regex& re, boost::match_results<std::string_view::const_iterator>& m)
 {
     std::size_t length = 0;
 
-    if (boost::regex_match(line, m, re))
+    if (boost::regex_match(line.begin(), line.end(), m, re))
         if (m.size() > 1)
             for (int i = 1; i < static_cast<int>(m.size()); ++i)
                 length += static_cast<std::size_t>(m[i].length());
@@ -53,7 +41,7 @@ std::size_t check_boost_regex(const std::string& line, const boost::regex& re, b
     return length;
 }
 
-std::size_t check_re2(const std::string& line, const re2::RE2& re, const std::vector<RE2::Arg*>& arguments_ptrs, const std::vector<std::string>& results, std::size_t args_count)
+std::size_t check_re2(const std::string_view line, const re2::RE2& re, const std::vector<RE2::Arg*>& arguments_ptrs, const std::vector<std::string>& results, std::size_t args_count)
 {
     std::size_t length = 0;
 
@@ -64,16 +52,28 @@ std::size_t check_re2(const std::string& line, const re2::RE2& re, const std::ve
     return length;
 }
 
-std::size_t check_pcre(const std::string& line, const pcre* re, const pcre_extra* sd)
+// Like check_re2, but the submatches are views into the line instead of copies.
+std::size_t check_re2_zero_copy(const std::string_view line, const re2::RE2& re, const RE2::Anchor anchor, std::vector<re2::StringPiece>& submatches)
+{
+    std::size_t length = 0;
+
+    if (re.Match(line, 0, line.size(), anchor, submatches.data(), static_cast<int>(submatches.size())))
+        for (std::size_t i = 1; i < submatches.size(); ++i)
+            length += submatches[i].size();
+
+    return length;
+}
+
+std::size_t check_pcre(const std::string_view line, const pcre* re, const pcre_extra* sd)
 {
     std::size_t length = 0;
     int ovector[OVECCOUNT];
 
-    const int rc = pcre_exec(re, sd, line.c_str(), static_cast<int>(line.size()), 0, 0, ovector, OVECCOUNT);
+    const int rc = pcre_exec(re, sd, line.data(), static_cast<int>(line.size()), 0, 0, ovector, OVECCOUNT);
 
     if (rc > 1) {
         for (int i = 1; i < rc; ++i) {
-            const char* substring_start = line.c_str() + ovector[2*i];
+            const char* substring_start = line.data() + ovector[2*i];
             const int substring_length = ovector[2*i + 1] - ovector[2*i];
             const std::string_view s{substring_start, static_cast<std::string_view::size_type>(substring_length)};
             length += s.size();
@@ -83,16 +83,16 @@ std::size_t check_pcre(const std::string& line, const pcre* re, const pcre_extra
     return length;
 }
 
-std::size_t check_pcre_jit(const std::string& line, const pcre* re, const pcre_extra* sd, pcre_jit_stack* jit_stack)
+std::size_t check_pcre_jit(const std::string_view line, const pcre* re, const pcre_extra* sd, pcre_jit_stack* jit_stack)
 {
     std::size_t length = 0;
     int ovector[OVECCOUNT];
 
-    const int rc = pcre_jit_exec(re, sd, line.c_str(), static_cast<int>(line.size()), 0, 0, ovector, OVECCOUNT, jit_stack);
+    const int rc = pcre_jit_exec(re, sd, line.data(), static_cast<int>(line.size()), 0, 0, ovector, OVECCOUNT, jit_stack);
 
     if (rc > 1) {
         for (int i = 1; i < rc; ++i) {
-            const char* substring_start = line.c_str() + ovector[2*i];
+            const char* substring_start = line.data() + ovector[2*i];
             const int substring_length = ovector[2*i + 1] - ovector[2*i];
             const std::string_view s{substring_start, static_cast<std::string_view::size_type>(substring_length)};
             length += s.size();
@@ -102,10 +102,10 @@ std::size_t check_pcre_jit(const std::string& line, const pcre* re, const pcre_e
     return length;
 }
 
-std::size_t check_pcre2(const std::string& line, const pcre2_code* re, pcre2_match_data* match_data)
+std::size_t check_pcre2(const std::string_view line, const pcre2_code* re, pcre2_match_data* match_data)
 {
     std::size_t length = 0;
-    const PCRE2_SPTR subject = reinterpret_cast<PCRE2_SPTR>(line.c_str());
+    const PCRE2_SPTR subject = reinterpret_cast<PCRE2_SPTR>(line.data());
 
     const int rc = pcre2_match(re, subject, line.size(), 0, 0, match_data, nullptr);
 
@@ -123,10 +123,10 @@ std::size_t check_pcre2(const std::string& line, const pcre2_code* re, pcre2_mat
     return length;
 }
 
-std::size_t check_pcre2_jit(const std::string& line, const pcre2_code* re, pcre2_match_data* match_data, pcre2_match_context* mcontext)
+std::size_t check_pcre2_jit(const std::string_view line, const pcre2_code* re, pcre2_match_data* match_data, pcre2_match_context* mcontext)
 {
     std::size_t length = 0;
-    const PCRE2_SPTR subject = reinterpret_cast<PCRE2_SPTR>(line.c_str());
+    const PCRE2_SPTR subject = reinterpret_cast<PCRE2_SPTR>(line.data());
 
     const int rc = pcre2_jit_match(re, subject, line.size(), 0, 0, match_data, mcontext);
 
@@ -144,539 +144,675 @@ std::size_t check_pcre2_jit(const std::string& line, const pcre2_code* re, pcre2
     return length;
 }
 
-std::vector<std::string> load_logfile()
+std::tuple<pcre*, pcre_extra*> init_pcre(const char* pattern)
 {
-    std::ifstream in("../logfile.txt");
-    std::vector<std::string> lines;
-    std::string line;
+    const char* error;
+    int erroroffset;
 
-    while (std::getline(in, line))
-        lines.push_back(line);
+    pcre* re = pcre_compile(pattern, 0, &error, &erroroffset, nullptr);
 
-    return lines;
-}
+    if (!re)
+        throw std::runtime_error{"PCRE compilation failed"};
 
-static void BM_OneLine_StdRegex(benchmark::State& state, const char* pattern)
-{
-    std::size_t length = 0;
-    const std::regex re{pattern};
-    std::smatch m;
+    pcre_extra* sd = pcre_study(re, 0, &error);
 
-    for (auto _ : state)
-        length += check_std_regex(one_line, re, m);
+    if (!sd && error)
+        throw std::runtime_error{"PCRE study error"};
 
-    state.counters["length"] = length;
+    return {re, sd};
 }
 
-static void BM_AllLines_StdRegex(benchmark::State& state, const char* pattern)
+pcre_jit_stack* init_pcre_jit_stack()
 {
-    std::size_t length = 0;
-    const std::regex re{pattern};
-    std::smatch m;
+    pcre_jit_stack* jit_stack = pcre_jit_stack_alloc(32*1024, 512*1024);
 
-    for (auto _ : state)
-        for (auto line : all_lines)
-            length += check_std_regex(line, re, m);
+    if (!jit_stack)
+        throw std::runtime_error{"PCRE JIT stack alloc error"};
 
-    state.counters["length"] = length;
+    return jit_stack;
 }
 
-static void BM_Logfile_StdRegex(benchmark::State& state, const char* pattern)
+std::tuple<pcre*, pcre_extra*> compile_pcre_jit(const char* pattern)
 {
-    std::size_t length = 0;
-    const std::regex re{pattern};
-    std::smatch m;
+    const char* error;
+    int erroroffset;
 
-    auto lines = load_logfile();
+    pcre* re = pcre_compile(pattern, 0, &error, &erroroffset, nullptr);
 
-    for (auto _ : state)
-        for (auto line : lines)
-            length += check_std_regex(line, re, m);
+    if (!re)
+        throw std::runtime_error{"PCRE compilation failed"};
+
+    pcre_extra* sd = pcre_study(re, PCRE_STUDY_JIT_COMPILE, &error);
+
+    if (!sd && error)
+        throw std::runtime_error{"PCRE study error"};
 
-    state.counters["length"] = length;
+    return {re, sd};
 }
 
-static void BM_OneLine_BoostRegex(benchmark::State& state, const char* pattern)
+std::tuple<pcre*, pcre_extra*, pcre_jit_stack*> init_pcre_jit(const char* pattern)
 {
-    std::size_t length = 0;
-    const boost::regex re{pattern};
-    boost::smatch m;
+    auto [re, sd] = compile_pcre_jit(pattern);
 
-    for (auto _ : state)
-        length += check_boost_regex(one_line, re, m);
+    pcre_jit_stack* jit_stack = init_pcre_jit_stack();
+    pcre_assign_jit_stack(sd, nullptr, jit_stack);
 
-    state.counters["length"] = length;
+    return {re, sd, jit_stack};
 }
 
-static void BM_AllLines_BoostRegex(benchmark::State& state, const char* pattern)
+pcre2_match_data* init_pcre2_match_data(const pcre2_code* re)
 {
-    std::size_t length = 0;
-    const boost::regex re{pattern};
-    boost::smatch m;
+    pcre2_match_data* match_data = pcre2_match_data_create_from_pattern(re, nullptr);
 
-    for (auto _ : state)
-        for (auto line : all_lines)
-            length += check_boost_regex(line, re, m);
+    if (!match_data)
+        throw std::runtime_error{"PCRE2 unable to create match data"};
 
-    state.counters["length"] = length;
+    return match_data;
 }
 
-static void BM_Logfile_BoostRegex(benchmark::State& state, const char* pattern)
+std::tuple<pcre2_match_context*, pcre2_jit_stack*> init_pcre2_jit_stack()
 {
-    std::size_t length = 0;
-    const boost::regex re{pattern};
-    boost::smatch m;
+    pcre2_match_context* mcontext = pcre2_match_context_create(nullptr);
 
-    auto lines = load_logfile();
+    if (!mcontext)
+        throw std::runtime_error{"PCRE2 unable to create match context"};
 
-    for (auto _ : state)
-        for (auto line : lines)
-            length += check_boost_regex(line, re, m);
+    pcre2_jit_stack* jit_stack = pcre2_jit_stack_create(32*1024, 512*1024, nullptr);
 
-    state.counters["length"] = length;
-}
+    if (!jit_stack)
+        throw std::runtime_error{"PCRE2 unable to create JIT stack"};
 
-static void BM_OneLine_RE2(benchmark::State& state, const char* pattern)
-{
-    std::size_t length = 0;
-    const re2::RE2 re{pattern};
+    pcre2_jit_stack_assign(mcontext, nullptr, jit_stack);
 
-    if (!re.ok())
-        throw std::runtime_error{"RE2 compilation error"};
+    return {mcontext, jit_stack};
+}
 
-    std::size_t args_count = static_cast<std::size_t>(re.NumberOfCapturingGroups());
+std::tuple<pcre2_code*, pcre2_match_data*> init_pcre2(const char* pattern)
+{
+    int errorcode;
+    PCRE2_SIZE erroroffset;
 
-    std::vector<RE2::Arg> arguments(args_count);
-    std::vector<RE2::Arg*> arguments_ptrs(args_count);
-    std::vector<std::string> results(args_count);
+    pcre2_code* re = pcre2_compile(reinterpret_cast<PCRE2_SPTR>(pattern), PCRE2_ZERO_TERMINATED, 0, &errorcode, &erroroffset, nullptr);
 
-    for (std::size_t i = 0; i < args_count; ++i) {
-        arguments[i] = &results[i];
-        arguments_ptrs[i] = &arguments[i];
-    }
+    if (!re)
+        throw std::runtime_error{"PCRE2 compilation failed"};
 
-    for (auto _ : state)
-        length += check_re2(one_line, re, arguments_ptrs, results, args_count);
+    pcre2_match_data* match_data = init_pcre2_match_data(re);
 
-    state.counters["length"] = length;
+    return {re, match_data};
 }
 
-static void BM_AllLines_RE2(benchmark::State& state, const char* pattern)
+pcre2_code* compile_pcre2_jit(const char* pattern)
 {
-    std::size_t length = 0;
-    const re2::RE2 re{pattern};
+    int errorcode;
+    PCRE2_SIZE erroroffset;
 
-    if (!re.ok())
-        throw std::runtime_error{"RE2 compilation error"};
+    pcre2_code* re = pcre2_compile(reinterpret_cast<PCRE2_SPTR>(pattern), PCRE2_ZERO_TERMINATED, 0, &errorcode, &erroroffset, nullptr);
 
-    std::size_t args_count = static_cast<std::size_t>(re.NumberOfCapturingGroups());
+    if (!re)
+        throw std::runtime_error{"PCRE2 compilation failed"};
 
-    std::vector<RE2::Arg> arguments(args_count);
-    std::vector<RE2::Arg*> arguments_ptrs(args_count);
-    std::vector<std::string> results(args_count);
+    if (pcre2_jit_compile(re, PCRE2_JIT_COMPLETE) < 0)
+        throw std::runtime_error{"PCRE2 JIT compile error"};
 
-    for (std::size_t i = 0; i < args_count; ++i) {
-        arguments[i] = &results[i];
-        arguments_ptrs[i] = &arguments[i];
-    }
+    return re;
+}
 
-    for (auto _ : state)
-        for (auto line : all_lines)
-            length += check_re2(line, re, arguments_ptrs, results, args_count);
+std::tuple<pcre2_code*, pcre2_match_context*, pcre2_jit_stack*, pcre2_match_data*> init_pcre2_jit(const char* pattern)
+{
+    pcre2_code* re = compile_pcre2_jit(pattern);
 
-    state.counters["length"] = length;
+    auto [mcontext, jit_stack] = init_pcre2_jit_stack();
+    pcre2_match_data* match_data = init_pcre2_match_data(re);
+
+    return {re, mcontext, jit_stack, match_data};
 }
 
-static void BM_Logfile_RE2(benchmark::State& state, const char* pattern)
+// Size of the compiled pattern plus its JIT code, if any.
+std::size_t pcre_compiled_size(const pcre* re, const pcre_extra* sd)
 {
-    std::size_t length = 0;
-    const re2::RE2 re{pattern};
-
-    if (!re.ok())
-        throw std::runtime_error{"RE2 compilation error"};
+    std::size_t size = 0;
+    std::size_t jit_size = 0;
 
-    std::size_t args_count = static_cast<std::size_t>(re.NumberOfCapturingGroups());
+    pcre_fullinfo(re, sd, PCRE_INFO_SIZE, &size);
 
-    std::vector<RE2::Arg> arguments(args_count);
-    std::vector<RE2::Arg*> arguments_ptrs(args_count);
-    std::vector<std::string> results(args_count);
+    if (sd)
+        pcre_fullinfo(re, sd, PCRE_INFO_JITSIZE, &jit_size);
 
-    for (std::size_t i = 0; i < args_count; ++i) {
-        arguments[i] = &results[i];
-        arguments_ptrs[i] = &arguments[i];
-    }
+    return size + jit_size;
+}
 
-    auto lines = load_logfile();
+std::size_t pcre2_compiled_size(const pcre2_code* re)
+{
+    std::size_t size = 0;
+    std::size_t jit_size = 0;
 
-    for (auto _ : state)
-        for (auto line : lines)
-            length += check_re2(line, re, arguments_ptrs, results, args_count);
+    pcre2_pattern_info(re, PCRE2_INFO_SIZE, &size);
+    pcre2_pattern_info(re, PCRE2_INFO_JITSIZE, &jit_size);
 
-    state.counters["length"] = length;
+    return size + jit_size;
 }
 
-std::tuple<pcre*, pcre_extra*> init_pcre(const char* pattern)
+// Compiles the pattern or deserializes it from the cache. Serialized PCRE2 code does not contain
+// JIT code, so with jit the pattern gets JIT compiled again after loading.
+std::shared_ptr<pcre2_code> compile_pcre2_cached(const PatternCache& cache, const std::string& pattern, const bool jit)
 {
-    const char* error;
-    int erroroffset;
+    constexpr std::uint32_t options = 0;
+    pcre2_code* re = nullptr;
 
-    pcre* re = pcre_compile(pattern, 0, &error, &erroroffset, nullptr);
+    if (const auto data = cache.load("PCRE2", pattern, options))
+        if (pcre2_serialize_decode(&re, 1, reinterpret_cast<const std::uint8_t*>(data->data()), nullptr) != 1)
+            re = nullptr;
 
-    if (!re)
-        throw std::runtime_error{"PCRE compilation failed"};
+    std::shared_ptr<pcre2_code> code{re, pcre2_code_free};
 
-    pcre_extra* sd = pcre_study(re, 0, &error);
+    if (!re) {
+        int errorcode;
+        PCRE2_SIZE erroroffset;
 
-    if (!sd && error)
-        throw std::runtime_error{"PCRE study error"};
+        re = pcre2_compile(reinterpret_cast<PCRE2_SPTR>(pattern.c_str()), pattern.size(), options, &errorcode, &erroroffset, nullptr);
 
-    return {re, sd};
-}
+        if (!re)
+            throw std::runtime_error{"PCRE2 compilation failed"};
 
-std::tuple<pcre*, pcre_extra*, pcre_jit_stack*> init_pcre_jit(const char* pattern)
-{
-    const char* error;
-    int erroroffset;
+        code.reset(re, pcre2_code_free);
 
-    pcre* re = pcre_compile(pattern, 0, &error, &erroroffset, nullptr);
+        const pcre2_code* codes[] = {re};
+        std::uint8_t* bytes;
+        PCRE2_SIZE size;
 
-    if (!re)
-        throw std::runtime_error{"PCRE compilation failed"};
+        if (pcre2_serialize_encode(codes, 1, &bytes, &size, nullptr) < 0)
+            throw std::runtime_error{"PCRE2 unable to serialize pattern"};
 
-    pcre_extra* sd = pcre_study(re, PCRE_STUDY_JIT_COMPILE, &error);
+        const std::unique_ptr<std::uint8_t, decltype(&pcre2_serialize_free)> serialized{bytes, pcre2_serialize_free};
+        cache.store("PCRE2", pattern, options, {reinterpret_cast<const char*>(bytes), size});
+    }
 
-    if (!sd && error)
-        throw std::runtime_error{"PCRE study error"};
+    if (jit && pcre2_jit_compile(re, PCRE2_JIT_COMPLETE) < 0)
+        throw std::runtime_error{"PCRE2 JIT compile error"};
 
-    pcre_jit_stack* jit_stack = pcre_jit_stack_alloc(32*1024, 512*1024);
+    return code;
+}
 
-    if (!jit_stack)
-        throw std::runtime_error{"PCRE JIT stack alloc error"};
+struct PCRE2CacheEngine {
+    static constexpr const char* name = "PCRE2";
+    static std::shared_ptr<pcre2_code> compile(const PatternCache& cache, const std::string& pattern) { return compile_pcre2_cached(cache, pattern, false); }
+};
 
-    pcre_assign_jit_stack(sd, nullptr, jit_stack);
+struct PCRE2JitCacheEngine {
+    static constexpr const char* name = "PCRE2_JIT";
+    static std::shared_ptr<pcre2_code> compile(const PatternCache& cache, const std::string& pattern) { return compile_pcre2_cached(cache, pattern, true); }
+};
 
-    return {re, sd, jit_stack};
-}
+// Matchers can be copied. Copies share the compiled pattern but get their own match state, so
+// that each thread can use its own copy.
 
-static void BM_OneLine_PCRE(benchmark::State& state, const char* pattern)
-{
-    std::size_t length = 0;
+class StdRegexMatcher {
+public:
+    static constexpr const char* name = "StdRegex";
 
-    auto [re, sd] = init_pcre(pattern);
+    explicit StdRegexMatcher(const char* pattern) : re_{pattern} {}
 
-    for (auto _ : state)
-        length += check_pcre(one_line, re, sd);
+    std::size_t match(const std::string_view line) { return check_std_regex(line, re_, m_); }
 
-    pcre_free_study(sd);
-    pcre_free(re);
+private:
+    const std::regex re_;
+    std::match_results<std::string_view::const_iterator> m_;
+};
 
-    state.counters["length"] = length;
-}
+class BoostRegexMatcher {
+public:
+    static constexpr const char* name = "BoostRegex";
 
-static void BM_AllLines_PCRE(benchmark::State& state, const char* pattern)
-{
-    std::size_t length = 0;
+    explicit BoostRegexMatcher(const char* pattern) : re_{pattern} {}
 
-    auto [re, sd] = init_pcre(pattern);
+    std::size_t match(const std::string_view line) { return check_boost_regex(line, re_, m_); }
 
-    for (auto _ : state)
-        for (auto line : all_lines)
-            length += check_pcre(line, re, sd);
+private:
+    const boost::regex re_;
+    boost::match_results<std::string_view::const_iterator> m_;
+};
 
-    pcre_free_study(sd);
-    pcre_free(re);
+class RE2Matcher {
+public:
+    static constexpr const char* name = "RE2";
 
-    state.counters["length"] = length;
-}
+    explicit RE2Matcher(const char* pattern) : re_{std::make_shared<const re2::RE2>(pattern)}
+    {
+        if (!re_->ok())
+            throw std::runtime_error{"RE2 compilation error"};
 
-static void BM_Logfile_PCRE(benchmark::State& state, const char* pattern)
-{
-    std::size_t length = 0;
+        init_arguments();
+    }
 
-    auto lines = load_logfile();
-    auto [re, sd] = init_pcre(pattern);
+    RE2Matcher(const RE2Matcher& other) : re_{other.re_} { init_arguments(); }
+    RE2Matcher& operator=(const RE2Matcher&) = delete;
 
-    for (auto _ : state)
-        for (auto line : lines)
-            length += check_pcre(line, re, sd);
+    std::size_t match(const std::string_view line) { return check_re2(line, *re_, arguments_ptrs_, results_, args_count_); }
 
-    pcre_free_study(sd);
-    pcre_free(re);
+private:
+    std::shared_ptr<const re2::RE2> re_;
+    std::size_t args_count_;
 
-    state.counters["length"] = length;
-}
+    std::vector<RE2::Arg> arguments_;
+    std::vector<RE2::Arg*> arguments_ptrs_;
+    std::vector<std::string> results_;
 
-static void BM_OneLine_PCRE_JIT(benchmark::State& state, const char* pattern)
-{
-    std::size_t length = 0;
+    void init_arguments()
+    {
+        args_count_ = static_cast<std::size_t>(re_->NumberOfCapturingGroups());
 
-    auto [re, sd, jit_stack] = init_pcre_jit(pattern);
+        arguments_.resize(args_count_);
+        arguments_ptrs_.resize(args_count_);
+        results_.resize(args_count_);
 
-    for (auto _ : state)
-        length += check_pcre_jit(one_line, re, sd, jit_stack);
+        for (std::size_t i = 0; i < args_count_; ++i) {
+            arguments_[i] = &results_[i];
+            arguments_ptrs_[i] = &arguments_[i];
+        }
+    }
+};
+
+// Matches with RE2::Match into an array of StringPiece submatches, so there are no copies of the
+// captured strings. With RE2::ANCHOR_BOTH the match has to cover the whole line like
+// RE2::FullMatchN in RE2Matcher, RE2::UNANCHORED searches like PCRE does.
+template <RE2::Anchor A>
+class RE2ZeroCopyMatcher {
+public:
+    static constexpr const char* name = A == RE2::ANCHOR_BOTH ? "RE2_ZeroCopy_AnchorBoth" : "RE2_ZeroCopy";
+
+    explicit RE2ZeroCopyMatcher(const char* pattern) : re_{std::make_shared<const re2::RE2>(pattern)}
+    {
+        if (!re_->ok())
+            throw std::runtime_error{"RE2 compilation error"};
+
+        submatches_.resize(static_cast<std::size_t>(re_->NumberOfCapturingGroups()) + 1);
+    }
 
-    pcre_jit_stack_free(jit_stack);
-    pcre_free_study(sd);
-    pcre_free(re);
+    std::size_t match(const std::string_view line) { return check_re2_zero_copy(line, *re_, A, submatches_); }
 
-    state.counters["length"] = length;
-}
+private:
+    std::shared_ptr<const re2::RE2> re_;
+    std::vector<re2::StringPiece> submatches_;
+};
 
-static void BM_AllLines_PCRE_JIT(benchmark::State& state, const char* pattern)
-{
-    std::size_t length = 0;
+class PCREMatcher {
+public:
+    static constexpr const char* name = "PCRE";
 
-    auto [re, sd, jit_stack] = init_pcre_jit(pattern);
+    explicit PCREMatcher(const char* pattern)
+    {
+        auto [re, sd] = init_pcre(pattern);
+        re_.reset(re, [](pcre* p) { pcre_free(p); });
+        sd_.reset(sd, pcre_free_study);
+    }
 
-    for (auto _ : state)
-        for (auto line : all_lines)
-            length += check_pcre_jit(line, re, sd, jit_stack);
+    std::size_t match(const std::string_view line) { return check_pcre(line, re_.get(), sd_.get()); }
+    std::size_t compiled_size() const { return pcre_compiled_size(re_.get(), sd_.get()); }
 
-    pcre_jit_stack_free(jit_stack);
-    pcre_free_study(sd);
-    pcre_free(re);
+private:
+    std::shared_ptr<pcre> re_;
+    std::shared_ptr<pcre_extra> sd_;
+};
 
-    state.counters["length"] = length;
-}
+class PCREJitMatcher {
+public:
+    static constexpr const char* name = "PCRE_JIT";
 
-static void BM_Logfile_PCRE_JIT(benchmark::State& state, const char* pattern)
-{
-    std::size_t length = 0;
+    explicit PCREJitMatcher(const char* pattern)
+    {
+        auto [re, sd, jit_stack] = init_pcre_jit(pattern);
+        re_.reset(re, [](pcre* p) { pcre_free(p); });
+        sd_.reset(sd, pcre_free_study);
+        jit_stack_ = jit_stack;
+    }
 
-    auto lines = load_logfile();
-    auto [re, sd, jit_stack] = init_pcre_jit(pattern);
+    PCREJitMatcher(const PCREJitMatcher& other) : re_{other.re_}, sd_{other.sd_}, jit_stack_{init_pcre_jit_stack()} {}
+    PCREJitMatcher& operator=(const PCREJitMatcher&) = delete;
 
-    for (auto _ : state)
-        for (auto line : lines)
-            length += check_pcre_jit(line, re, sd, jit_stack);
+    ~PCREJitMatcher() { pcre_jit_stack_free(jit_stack_); }
 
-    pcre_jit_stack_free(jit_stack);
-    pcre_free_study(sd);
-    pcre_free(re);
+    std::size_t match(const std::string_view line) { return check_pcre_jit(line, re_.get(), sd_.get(), jit_stack_); }
+    std::size_t compiled_size() const { return pcre_compiled_size(re_.get(), sd_.get()); }
 
-    state.counters["length"] = length;
-}
+private:
+    std::shared_ptr<pcre> re_;
+    std::shared_ptr<pcre_extra> sd_;
+    pcre_jit_stack* jit_stack_;
+};
 
-std::tuple<pcre2_code*, pcre2_match_data*> init_pcre2(const char* pattern)
-{
-    int errorcode;
-    PCRE2_SIZE erroroffset;
+class PCRE2Matcher {
+public:
+    static constexpr const char* name = "PCRE2";
 
-    pcre2_code* re = pcre2_compile(reinterpret_cast<PCRE2_SPTR>(pattern), PCRE2_ZERO_TERMINATED, 0, &errorcode, &erroroffset, nullptr);
+    explicit PCRE2Matcher(const char* pattern)
+    {
+        auto [re, match_data] = init_pcre2(pattern);
+        re_.reset(re, pcre2_code_free);
+        match_data_ = match_data;
+    }
 
-    if (!re)
-        throw std::runtime_error{"PCRE2 compilation failed"};
+    PCRE2Matcher(const PCRE2Matcher& other) : re_{other.re_}, match_data_{init_pcre2_match_data(re_.get())} {}
+    PCRE2Matcher& operator=(const PCRE2Matcher&) = delete;
 
-    pcre2_match_data* match_data = pcre2_match_data_create_from_pattern(re, nullptr);
+    ~PCRE2Matcher() { pcre2_match_data_free(match_data_); }
 
-    if (!match_data)
-        throw std::runtime_error{"PCRE2 unable to create match data"};
+    std::size_t match(const std::string_view line) { return check_pcre2(line, re_.get(), match_data_); }
+    std::size_t compiled_size() const { return pcre2_compiled_size(re_.get()); }
 
-    return {re, match_data};
-}
+private:
+    std::shared_ptr<pcre2_code> re_;
+    pcre2_match_data* match_data_;
+};
 
-std::tuple<pcre2_code*, pcre2_match_context*, pcre2_jit_stack*, pcre2_match_data*> init_pcre2_jit(const char* pattern)
-{
-    int errorcode;
-    PCRE2_SIZE erroroffset;
+class PCRE2JitMatcher {
+public:
+    static constexpr const char* name = "PCRE2_JIT";
 
-    pcre2_code* re = pcre2_compile(reinterpret_cast<PCRE2_SPTR>(pattern), PCRE2_ZERO_TERMINATED, 0, &errorcode, &erroroffset, nullptr);
+    explicit PCRE2JitMatcher(const char* pattern)
+    {
+        auto [re, mcontext, jit_stack, match_data] = init_pcre2_jit(pattern);
+        re_.reset(re, pcre2_code_free);
+        mcontext_ = mcontext;
+        jit_stack_ = jit_stack;
+        match_data_ = match_data;
+    }
 
-    if (!re)
-        throw std::runtime_error{"PCRE2 compilation failed"};
+    PCRE2JitMatcher(const PCRE2JitMatcher& other) : re_{other.re_}, match_data_{init_pcre2_match_data(re_.get())}
+    {
+        std::tie(mcontext_, jit_stack_) = init_pcre2_jit_stack();
+    }
 
-    if (pcre2_jit_compile(re, PCRE2_JIT_COMPLETE) < 0)
-        throw std::runtime_error{"PCRE2 JIT compile error"};
+    PCRE2JitMatcher& operator=(const PCRE2JitMatcher&) = delete;
 
-    pcre2_match_context* mcontext = pcre2_match_context_create(nullptr);
+    ~PCRE2JitMatcher()
+    {
+        pcre2_match_data_free(match_data_);
+        pcre2_jit_stack_free(jit_stack_);
+        pcre2_match_context_free(mcontext_);
+    }
 
-    if (!mcontext)
-        throw std::runtime_error{"PCRE2 unable to create match context"};
+    std::size_t match(const std::string_view line) { return check_pcre2_jit(line, re_.get(), match_data_, mcontext_); }
+    std::size_t compiled_size() const { return pcre2_compiled_size(re_.get()); }
+
+private:
+    std::shared_ptr<pcre2_code> re_;
+    pcre2_match_data* match_data_;
+    pcre2_match_context* mcontext_;
+    pcre2_jit_stack* jit_stack_;
+};
+
+// Matches one of the patterns regex1 .. regex3 with the matcher generated at compile time. The
+// runtime pattern only has to be the same.
+template <compile_time_regex::FixedString P>
+class CompileTimeRegexMatcher {
+public:
+    static constexpr const char* name = "CompileTimeRegex";
+
+    explicit CompileTimeRegexMatcher(const char* pattern)
+    {
+        if (std::string_view{pattern} != P.view())
+            throw std::runtime_error{"CompileTimeRegexMatcher constructed with a different pattern"};
+    }
 
-    pcre2_jit_stack* jit_stack = pcre2_jit_stack_create(32*1024, 512*1024, nullptr);
+    std::size_t match(const std::string_view line)
+    {
+        std::size_t length = 0;
 
-    if (!jit_stack)
-        throw std::runtime_error{"PCRE2 unable to create JIT stack"};
+        if (compile_time_regex::Regex<P>::search(line, captures_))
+            for (std::size_t i = 1; i < captures_.size(); ++i)
+                length += captures_[i].size();
 
-    pcre2_jit_stack_assign(mcontext, nullptr, jit_stack);
+        return length;
+    }
 
-    pcre2_match_data* match_data = pcre2_match_data_create_from_pattern(re, nullptr);
+private:
+    typename compile_time_regex::Regex<P>::Captures captures_;
+};
+
+// Thread-safe variants of the JIT matchers for BM_Logfile_ThreadLocal: one compiled pattern for
+// all threads, the JIT stack and match data of each thread come from a PerThreadState.
+class ThreadLocalPCREJitMatcher {
+public:
+    static constexpr const char* name = "PCRE_JIT";
+
+    explicit ThreadLocalPCREJitMatcher(const char* pattern)
+    {
+        auto [re, sd] = compile_pcre_jit(pattern);
+        re_.reset(re, [](pcre* p) { pcre_free(p); });
+        sd_.reset(sd, pcre_free_study);
+    }
 
-    if (!match_data)
-        throw std::runtime_error{"PCRE2 unable to create match data"};
+    std::size_t match(const std::string_view line) const { return check_pcre_jit(line, re_.get(), sd_.get(), jit_stack_.get().get()); }
 
-    return {re, mcontext, jit_stack, match_data};
-}
+private:
+    std::shared_ptr<pcre> re_;
+    std::shared_ptr<pcre_extra> sd_;
+    PerThreadState<std::unique_ptr<pcre_jit_stack, decltype(&pcre_jit_stack_free)>> jit_stack_{
+        [] { return std::unique_ptr<pcre_jit_stack, decltype(&pcre_jit_stack_free)>{init_pcre_jit_stack(), pcre_jit_stack_free}; }};
+};
 
-static void BM_OneLine_PCRE2(benchmark::State& state, const char* pattern)
-{
-    std::size_t length = 0;
+class ThreadLocalPCRE2JitMatcher {
+public:
+    static constexpr const char* name = "PCRE2_JIT";
 
-    auto [re, match_data] = init_pcre2(pattern);
+    explicit ThreadLocalPCRE2JitMatcher(const char* pattern) : re_{compile_pcre2_jit(pattern), pcre2_code_free} {}
 
-    for (auto _ : state)
-        length += check_pcre2(one_line, re, match_data);
+    std::size_t match(const std::string_view line) const
+    {
+        const MatchState& match_state = match_state_.get();
+        return check_pcre2_jit(line, re_.get(), match_state.match_data.get(), match_state.mcontext.get());
+    }
 
-    pcre2_match_data_free(match_data);
-    pcre2_code_free(re);
+private:
+    struct MatchState {
+        std::unique_ptr<pcre2_match_data, decltype(&pcre2_match_data_free)> match_data;
+        std::unique_ptr<pcre2_match_context, decltype(&pcre2_match_context_free)> mcontext;
+        std::unique_ptr<pcre2_jit_stack, decltype(&pcre2_jit_stack_free)> jit_stack;
+    };
+
+    std::shared_ptr<pcre2_code> re_;
+    PerThreadState<MatchState> match_state_{[re = re_] {
+        auto [mcontext, jit_stack] = init_pcre2_jit_stack();
+        return MatchState{{init_pcre2_match_data(re.get()), pcre2_match_data_free}, {mcontext, pcre2_match_context_free}, {jit_stack, pcre2_jit_stack_free}};
+    }};
+};
+
+// Two-stage classification by many patterns: RE2::Set finds all patterns matching a line in one
+// pass, then only these candidates get matched with the capturing Matcher M.
+template <Matcher M>
+class PrefilteredMultiMatcher {
+public:
+    explicit PrefilteredMultiMatcher(const std::vector<std::string>& patterns) : set_{set_options(), RE2::UNANCHORED}
+    {
+        for (const auto& pattern : patterns) {
+            std::string error;
+
+            if (set_.Add(pattern, &error) < 0)
+                throw std::runtime_error{"RE2::Set unable to add pattern: " + error};
+
+            matchers_.emplace_back(pattern.c_str());
+        }
 
-    state.counters["length"] = length;
-}
+        if (!set_.Compile())
+            throw std::runtime_error{"RE2::Set compilation error"};
+    }
 
-static void BM_AllLines_PCRE2(benchmark::State& state, const char* pattern)
-{
-    std::size_t length = 0;
+    // Returns the number of patterns matching the line.
+    std::size_t match(const std::string_view line)
+    {
+        std::size_t matches = 0;
 
-    auto [re, match_data] = init_pcre2(pattern);
+        if (set_.Match(line, &candidates_))
+            for (const int candidate : candidates_)
+                if (matchers_[static_cast<std::size_t>(candidate)].match(line) > 0)
+                    ++matches;
 
-    for (auto _ : state)
-        for (auto line : all_lines)
-            length += check_pcre2(line, re, match_data);
+        return matches;
+    }
 
-    pcre2_match_data_free(match_data);
-    pcre2_code_free(re);
+private:
+    re2::RE2::Set set_;
+    std::vector<M> matchers_;
+    std::vector<int> candidates_;
 
-    state.counters["length"] = length;
-}
+    static RE2::Options set_options()
+    {
+        RE2::Options options;
+        options.set_max_mem(256 << 20);
+        return options;
+    }
+};
 
-static void BM_Logfile_PCRE2(benchmark::State& state, const char* pattern)
+// Same classification as BM_Logfile_MultiPattern, but with the RE2::Set prefilter.
+template <Matcher M>
+void BM_Logfile_Prefiltered(benchmark::State& state)
 {
-    std::size_t length = 0;
+    std::size_t matches = 0;
 
-    auto lines = load_logfile();
-    auto [re, match_data] = init_pcre2(pattern);
+    const CorpusLines corpus_lines = load_logfile_mapped();
+    PrefilteredMultiMatcher<M> matcher{make_multi_patterns(static_cast<std::size_t>(state.range(0)))};
 
     for (auto _ : state)
-        for (auto line : lines)
-            length += check_pcre2(line, re, match_data);
-
-    pcre2_match_data_free(match_data);
-    pcre2_code_free(re);
+        for (const auto& line : corpus_lines.lines())
+            matches += matcher.match(line);
 
-    state.counters["length"] = length;
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(corpus_lines.bytes()));
+    state.counters["matches"] = benchmark::Counter(static_cast<double>(matches), benchmark::Counter::kAvgIterations);
 }
 
-static void BM_OneLine_PCRE2_JIT(benchmark::State& state, const char* pattern)
+template <Matcher... Matchers>
+bool register_prefiltered_benchmarks()
 {
-    std::size_t length = 0;
+    (benchmark::RegisterBenchmark(("BM_Logfile_Prefiltered_" + std::string{Matchers::name}).c_str(), BM_Logfile_Prefiltered<Matchers>)
+         ->Arg(1)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond), ...);
 
-    auto [re, mcontext, jit_stack, match_data] = init_pcre2_jit(pattern);
+    return true;
+}
 
-    for (auto _ : state)
-        length += check_pcre2_jit(one_line, re, match_data, mcontext);
+// Compares the fields of HandParser with the capture spans of PCRE2 on randomly mutated log lines.
+// Mutations mostly use the delimiters of the log format to hit the edge cases of the parser.
+// The benchmark fails if any line gets parsed differently.
+static void BM_HandParser_Consistency(benchmark::State& state)
+{
+    const std::string_view alphabet = " |[](),:0123456789ms";
+    std::mt19937 gen{42};
+    std::size_t mismatches = 0;
 
-    pcre2_match_data_free(match_data);
-    pcre2_jit_stack_free(jit_stack);
-    pcre2_match_context_free(mcontext);
-    pcre2_code_free(re);
+    auto [re, match_data] = init_pcre2(regex2);
+    std::vector<std::string> lines{all_lines};
+    lines.push_back(one_line);
 
-    state.counters["length"] = length;
-}
+    for (auto _ : state) {
+        std::string line = lines[gen() % lines.size()];
 
-static void BM_AllLines_PCRE2_JIT(benchmark::State& state, const char* pattern)
-{
-    std::size_t length = 0;
+        for (auto mutations = gen() % 4; mutations > 0 && !line.empty(); --mutations) {
+            const std::size_t pos = gen() % line.size();
+            const char c = gen() % 4 == 0 ? static_cast<char>(gen() % 256) : alphabet[gen() % alphabet.size()];
 
-    auto [re, mcontext, jit_stack, match_data] = init_pcre2_jit(pattern);
+            switch (gen() % 3) {
+                case 0: line[pos] = c; break;
+                case 1: line.insert(pos, 1, c); break;
+                default: line.erase(pos, 1); break;
+            }
+        }
 
-    for (auto _ : state)
-        for (auto line : all_lines)
-            length += check_pcre2_jit(line, re, match_data, mcontext);
+        const int rc = pcre2_match(re, reinterpret_cast<PCRE2_SPTR>(line.data()), line.size(), 0, 0, match_data, nullptr);
+        const auto fields = parse_log_line(line);
+
+        if ((rc > 0) != fields.has_value()) {
+            ++mismatches;
+        } else if (fields) {
+            const PCRE2_SIZE* ovector = pcre2_get_ovector_pointer(match_data);
+            const std::string_view captures[] = {fields->request_id, fields->timestamp, fields->handler, fields->ms};
+
+            for (std::size_t i = 0; i < std::size(captures); ++i) {
+                if (static_cast<PCRE2_SIZE>(captures[i].data() - line.data()) != ovector[2*i + 2] || captures[i].size() != ovector[2*i + 3] - ovector[2*i + 2]) {
+                    ++mismatches;
+                    break;
+                }
+            }
+        }
+    }
 
     pcre2_match_data_free(match_data);
-    pcre2_jit_stack_free(jit_stack);
-    pcre2_match_context_free(mcontext);
     pcre2_code_free(re);
 
-    state.counters["length"] = length;
+    state.counters["mismatches"] = static_cast<double>(mismatches);
+
+    if (mismatches > 0)
+        state.SkipWithError("HandParser differs from PCRE2");
 }
 
-static void BM_Logfile_PCRE2_JIT(benchmark::State& state, const char* pattern)
+BENCHMARK(BM_HandParser_Consistency)->Iterations(100000);
+
+// Checks required_literal() against expected literals and makes sure that every subject PCRE2
+// matches contains the literal, otherwise LiteralFilter would reject lines which really match.
+static void BM_RequiredLiteral_Consistency(benchmark::State& state)
 {
-    std::size_t length = 0;
+    const std::pair<const char*, std::string> cases[] = {
+        {"a{", ""},
+        {"ab{2}cd", "ab"},
+        {"x{,3}yz", "yz"},
+        {"abc\\x41def", ""},
+        {"abc\\012def", ""},
+        {"\\p{Lu}xyzw", ""},
+        {"(\\Q)\\E)abcd", ""},
+        {"\\Q.*\\Eabcd", ""},
+        {"abc\\d+defgh", "defgh"},
+        {"[^]a]bcd", "bcd"},
+        {regex1, required_literal(regex1)},
+        {regex2, required_literal(regex2)},
+        {regex3, required_literal(regex3)}};
 
-    auto lines = load_logfile();
-    auto [re, mcontext, jit_stack, match_data] = init_pcre2_jit(pattern);
+    std::vector<std::string> subjects{all_lines};
+    subjects.insert(subjects.end(), {one_line, "a{", "abbcd", "yz", "xxxyz", "abcAdef", "abc\ndef", "Xxyzw", ")abcd", ".*abcd", "abc1defgh", "]bcd"});
 
-    if (!match_data)
-        throw std::runtime_error{"PCRE2 unable to create match data"};
+    std::size_t mismatches = 0;
 
-    for (auto _ : state)
-        for (auto line : lines)
-            length += check_pcre2_jit(line, re, match_data, mcontext);
+    for (auto _ : state) {
+        for (const auto& [pattern, expected] : cases) {
+            const std::string literal = required_literal(pattern);
 
-    pcre2_match_data_free(match_data);
-    pcre2_jit_stack_free(jit_stack);
-    pcre2_match_context_free(mcontext);
-    pcre2_code_free(re);
+            if (literal != expected) {
+                ++mismatches;
+                continue;
+            }
 
-    state.counters["length"] = length;
-}
+            auto [re, match_data] = init_pcre2(pattern);
+
+            for (const auto& subject : subjects)
+                if (pcre2_match(re, reinterpret_cast<PCRE2_SPTR>(subject.data()), subject.size(), 0, 0, match_data, nullptr) > 0 && !contains_literal(subject, literal))
+                    ++mismatches;
+
+            pcre2_match_data_free(match_data);
+            pcre2_code_free(re);
+        }
+    }
 
-BENCHMARK_CAPTURE(BM_OneLine_BoostRegex, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_BoostRegex, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_BoostRegex, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_PCRE, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_PCRE, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_PCRE, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_PCRE2, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_PCRE2, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_PCRE2, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_PCRE2_JIT, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_PCRE2_JIT, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_PCRE2_JIT, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_PCRE_JIT, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_PCRE_JIT, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_PCRE_JIT, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_RE2, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_RE2, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_RE2, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_StdRegex, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_StdRegex, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_StdRegex, 3, regex3)->Unit(benchmark::kMicrosecond);
-
-BENCHMARK_CAPTURE(BM_AllLines_BoostRegex, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_BoostRegex, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_BoostRegex, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_PCRE, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_PCRE, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_PCRE, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_PCRE2, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_PCRE2, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_PCRE2, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_PCRE2_JIT, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_PCRE2_JIT, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_PCRE2_JIT, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_PCRE_JIT, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_PCRE_JIT, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_PCRE_JIT, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_RE2, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_RE2, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_RE2, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_StdRegex, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_StdRegex, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_StdRegex, 3, regex3)->Unit(benchmark::kMicrosecond);
-
-BENCHMARK_CAPTURE(BM_Logfile_BoostRegex, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_BoostRegex, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_BoostRegex, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_PCRE, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_PCRE, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_PCRE, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_PCRE2, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_PCRE2, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_PCRE2, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_PCRE2_JIT, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_PCRE2_JIT, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_PCRE2_JIT, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_PCRE_JIT, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_PCRE_JIT, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_PCRE_JIT, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_RE2, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_RE2, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_RE2, 3, regex3)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_StdRegex, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_StdRegex, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_StdRegex, 3, regex3)->Unit(benchmark::kMicrosecond);
+    state.counters["mismatches"] = static_cast<double>(mismatches);
+
+    if (mismatches > 0)
+        state.SkipWithError("required_literal() misses matching lines");
+}
+
+BENCHMARK(BM_RequiredLiteral_Consistency)->Iterations(1);
+
+static const bool match_benchmarks_registered = register_match_benchmarks<BoostRegexMatcher, PCREMatcher, PCRE2Matcher, PCRE2JitMatcher, PCREJitMatcher, RE2Matcher, StdRegexMatcher>(
+    {{"1", regex1}, {"2", regex2}, {"3", regex3}});
+static const bool re2_zero_copy_benchmarks_registered = register_match_benchmarks<RE2ZeroCopyMatcher<RE2::UNANCHORED>, RE2ZeroCopyMatcher<RE2::ANCHOR_BOTH>>(
+    {{"1", regex1}, {"2", regex2}, {"3", regex3}});
+static const bool literal_filter_benchmarks_registered = register_match_benchmarks<LiteralFilter<BoostRegexMatcher>, LiteralFilter<PCREMatcher>, LiteralFilter<PCRE2Matcher>,
+    LiteralFilter<PCRE2JitMatcher>, LiteralFilter<PCREJitMatcher>, LiteralFilter<RE2Matcher>, LiteralFilter<StdRegexMatcher>>({{"1", regex1}, {"2", regex2}, {"3", regex3}});
+static const bool compile_time_regex_benchmarks_registered = register_match_benchmarks<CompileTimeRegexMatcher<regex1>>({{"1", regex1}})
+    && register_match_benchmarks<CompileTimeRegexMatcher<regex2>>({{"2", regex2}}) && register_match_benchmarks<CompileTimeRegexMatcher<regex3>>({{"3", regex3}});
+static const bool hand_parser_benchmarks_registered = register_match_benchmarks<HandParser>({{"2", regex2}});
+static const bool compile_benchmarks_registered = register_compile_benchmarks<BoostRegexMatcher, PCREMatcher, PCRE2Matcher, PCRE2JitMatcher, PCREJitMatcher, RE2Matcher, StdRegexMatcher>();
+static const bool pattern_cache_benchmarks_registered = register_pattern_cache_benchmarks<PCRE2CacheEngine, PCRE2JitCacheEngine>();
+static const bool thread_local_benchmarks_registered = register_thread_local_benchmarks<ThreadLocalPCRE2JitMatcher, ThreadLocalPCREJitMatcher>();
+static const bool synthetic_benchmarks_registered = register_synthetic_benchmarks<HandParser, PCRE2JitMatcher, RE2Matcher>({"2", regex2});
+static const bool load_benchmarks_registered = register_load_benchmarks<PCRE2JitMatcher, RE2Matcher, StdRegexMatcher>({"2", regex2});
+static const bool multi_pattern_benchmarks_registered = register_multi_pattern_benchmarks<PCRE2JitMatcher, RE2Matcher>();
+static const bool prefiltered_benchmarks_registered = register_prefiltered_benchmarks<PCRE2JitMatcher, RE2Matcher>();
 
 BENCHMARK_MAIN();
@@ -0,0 +1,1244 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <bit>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include "thread_pool.h"
+
+// Test data and benchmark templates shared by regex.cpp and regex_hyperscan.cpp.
+
+// Counts every allocation made through operator new, for the allocations counters. The counters
+// are per thread, so that counting does not make threads contend for a shared cache line. They
+// cover the allocations of the benchmark thread which reads them. This header gets included by
+// exactly one translation unit per executable.
+inline thread_local std::size_t allocation_count = 0;
+inline thread_local std::size_t allocated_bytes = 0;
+
+void* operator new(const std::size_t size)
+{
+    ++allocation_count;
+    allocated_bytes += size;
+
+    if (void* p = std::malloc(size > 0 ? size : 1))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+// GCC warns about free() on memory from operator new once these get inlined.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+const std::string one_line{"[00180D0F | 2009-09-15 09:34:48] (127.0.0.1:39170, 879) /cmd.php [co_search.browse] RQST END   [normal]   799 ms"};
+const std::vector<std::string> all_lines{
+    "[05821BE4 | 2019-05-13 12:28:56] (13036) http://test.site/projects/cmd.php [co_project.view] RQST START",
+    "[05821BE4 | 2019-05-13 12:28:56] (13036) http://test.site/projects/cmd.php [co_project.view] RQST END   [normal]   402 ms",
+    "[05671FA1 | 2019-04-17 14:08:03] (62931) http://test.site/projects/cmd.php [co_project.view] RQST START",
+    "[05671FA1 | 2019-04-17 14:08:03] (62931) http://test.site/projects/cmd.php [co_project.view] RQST END   [normal]   237 ms",
+    "[05822AE4 | 2019-06-17 06:59:03] (15828) http://test.site/cmd.php [co_project.dialog_doc_details] RQST START",
+    "[05822AE4 | 2019-06-17 06:59:03] (15828) http://test.site/cmd.php [co_project.dialog_doc_details] RQST END   [normal]   318 ms",
+    "[00180D0F | 2009-09-15 09:34:47] (127.0.0.1:39170, 879) /cmd.php [co_search.browse] RQST START",
+    "[00180D0F | 2009-09-15 09:34:48] (127.0.0.1:39170, 879) /cmd.php [co_search.browse] RQST END   [normal]   799 ms",
+    "[00180D0D | 2009-09-15 09:34:19] (127.0.0.1:39169, 23727) /browse/ RQST START",
+    "[00180D0D | 2009-09-15 09:34:19] (127.0.0.1:39169, 23727) /browse/ RQST END   [normal]    35 ms",
+    "[001F86EA | 2009-11-02 16:05:50] (127.0.0.1:1789, 10994) /cmd.php [co_doc.details] RQST START",
+    "[001F86EA | 2009-11-02 16:05:50] (127.0.0.1:1789, 10994) /cmd.php [co_doc.details] RQST END   [normal]    84 ms"};
+
+constexpr char regex1[] = R"(\[(.+) \| ([^\]]+)\] \((.+, )?(\d+)\) (.+) \[(.+)\] RQST END   \[(.+)\] *(\d+) ms)";
+constexpr char regex2[] = R"(\[([^ ]{8}) \| ([^\]]{19})\] \((?:[^,]+, )?\d+\) [^ ]+ \[([^\]]+)\] RQST END   \[[^\]]+\] *(\d+) ms)";
+constexpr char regex3[] = R"(^\[([^ ]{8}) \| ([^\]]{19})\] \((?:[^,]+, )?\d+\) [^ ]+ \[([^\]]+)\] RQST END   \[[^\]]+\] *(\d+) ms)";
+
+// Lines match with a probability of match_threshold / 1000000. Rounded, so that 0.29 does not
+// become 289999.
+inline std::uint64_t logfile_match_threshold(const double match_ratio)
+{
+    return static_cast<std::uint64_t>(std::llround(match_ratio * 1000000.0));
+}
+
+// Writes a log file of at least size bytes in the format of all_lines. A match_ratio share of the
+// lines are "RQST END" lines which match regex1 .. regex3, the others are "RQST START" lines. The
+// output only depends on the arguments: std::mt19937_64 is fully specified by the standard and its
+// numbers are used directly instead of through the implementation-defined distributions.
+inline void generate_logfile(const std::filesystem::path& filename, const std::uint64_t size, const double match_ratio, const std::uint64_t seed = 1)
+{
+    static constexpr const char* urls[] = {"http://test.site/projects/cmd.php", "http://test.site/cmd.php", "/cmd.php", "/browse/"};
+    static constexpr const char* handlers[] = {"co_project.view", "co_project.dialog_doc_details", "co_search.browse", "co_doc.details"};
+
+    std::mt19937_64 gen{seed};
+    const auto random = [&](const std::uint64_t n) { return static_cast<unsigned int>(gen() % n); };
+    const std::uint64_t match_threshold = logfile_match_threshold(match_ratio);
+
+    std::ofstream out(filename, std::ios::binary);
+    std::string buffer;
+    std::uint64_t written = 0;
+    char line[256];
+
+    while (written < size) {
+        // one random number per statement, the evaluation order of function arguments is unspecified
+        const unsigned int request_id = random(0x10000000);
+        const unsigned int year = 2009 + random(11);
+        const unsigned int month = 1 + random(12);
+        const unsigned int day = 1 + random(28);
+        const unsigned int seconds = random(24 * 60 * 60);
+        const bool with_address = random(2) == 1;
+        const unsigned int port = 1024 + random(64000);
+        const unsigned int pid = 1 + random(65535);
+        const char* url = urls[random(std::size(urls))];
+        const char* handler = handlers[random(std::size(handlers))];
+        const bool matching = gen() % 1000000 < match_threshold;
+        const unsigned int ms = random(5000);
+
+        int n = std::snprintf(line, sizeof(line), "[%08X | %04u-%02u-%02u %02u:%02u:%02u] ", request_id, year, month, day, seconds / 3600, seconds / 60 % 60, seconds % 60);
+
+        if (with_address)
+            n += std::snprintf(line + n, sizeof(line) - static_cast<std::size_t>(n), "(127.0.0.1:%u, %u) ", port, pid);
+        else
+            n += std::snprintf(line + n, sizeof(line) - static_cast<std::size_t>(n), "(%u) ", pid);
+
+        n += std::snprintf(line + n, sizeof(line) - static_cast<std::size_t>(n), "%s [%s] ", url, handler);
+
+        if (matching)
+            n += std::snprintf(line + n, sizeof(line) - static_cast<std::size_t>(n), "RQST END   [normal]%6u ms\n", ms);
+        else
+            n += std::snprintf(line + n, sizeof(line) - static_cast<std::size_t>(n), "RQST START\n");
+
+        buffer.append(line, static_cast<std::size_t>(n));
+        written += static_cast<std::uint64_t>(n);
+
+        if (buffer.size() >= (1 << 20) || written >= size) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+
+    if (!out)
+        throw std::runtime_error{"unable to write " + filename.string()};
+}
+
+// A name next to filename which no other process or thread uses. Files get written under this
+// name first and then renamed, so that nobody ever sees a partially written file.
+inline std::filesystem::path unique_temporary_path(const std::filesystem::path& filename)
+{
+    static std::atomic<unsigned int> counter{0};
+
+    const auto time = static_cast<unsigned long long>(std::chrono::steady_clock::now().time_since_epoch().count());
+    char suffix[64];
+    std::snprintf(suffix, sizeof(suffix), ".%08x%016llx%u.tmp", std::random_device{}(), time, counter.fetch_add(1));
+
+    return filename.string() + suffix;
+}
+
+// Generates a log file with generate_logfile() once and reuses it in later runs. The files are
+// kept in the temp directory, their names contain the size and the exact match threshold.
+inline std::filesystem::path synthetic_logfile(const std::uint64_t size, const double match_ratio)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "regex_benchmark_corpus";
+    const std::filesystem::path filename = directory / ("logfile_" + std::to_string(size) + "_" + std::to_string(logfile_match_threshold(match_ratio)) + ".txt");
+
+    if (!std::filesystem::exists(filename)) {
+        std::filesystem::create_directories(directory);
+
+        // a run that gets interrupted leaves only the temporary file behind
+        const std::filesystem::path temporary = unique_temporary_path(filename);
+
+        try {
+            generate_logfile(temporary, size, match_ratio);
+            std::filesystem::rename(temporary, filename);
+        } catch (...) {
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+            throw;
+        }
+    }
+
+    return filename;
+}
+
+// The Logfile benchmarks use ../logfile.txt if it exists and otherwise a synthetic log file of
+// 1 MB with half of the lines matching.
+inline std::filesystem::path logfile_path()
+{
+    const std::filesystem::path filename{"../logfile.txt"};
+    return std::filesystem::exists(filename) ? filename : synthetic_logfile(1 << 20, 0.5);
+}
+
+inline std::vector<std::string> load_logfile()
+{
+    std::ifstream in(logfile_path());
+    std::vector<std::string> lines;
+    std::string line;
+
+    while (std::getline(in, line))
+        lines.push_back(line);
+
+    return lines;
+}
+
+// Read-only memory mapping of a whole file. Without mmap the file gets read into memory instead.
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& filename)
+    {
+#ifdef _WIN32
+        std::ifstream in(filename, std::ios::binary);
+
+        if (!in)
+            throw std::runtime_error{"unable to open " + filename.string()};
+
+        buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data_ = buffer_;
+#else
+        const int fd = open(filename.c_str(), O_RDONLY);
+
+        if (fd < 0)
+            throw std::runtime_error{"unable to open " + filename.string()};
+
+        struct stat st;
+
+        if (fstat(fd, &st) < 0) {
+            close(fd);
+            throw std::runtime_error{"unable to stat " + filename.string()};
+        }
+
+        const auto size = static_cast<std::size_t>(st.st_size);
+
+        if (size > 0) {
+            void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (data == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error{"unable to map " + filename.string()};
+            }
+
+            madvise(data, size, MADV_SEQUENTIAL);
+            data_ = std::string_view{static_cast<const char*>(data), size};
+        }
+
+        close(fd);
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifndef _WIN32
+        if (!data_.empty())
+            munmap(const_cast<char*>(data_.data()), data_.size());
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view data() const { return data_; }
+
+private:
+    std::string_view data_;
+#ifdef _WIN32
+    std::string buffer_;
+#endif
+};
+
+// Calls f with every line of the buffer like std::getline: without the '\n' and without an empty
+// line after a final line break. The newlines are found 16 bytes at a time with SSE2.
+template <typename F>
+void for_each_line(const std::string_view buffer, F&& f)
+{
+    const char* const end = buffer.data() + buffer.size();
+    const char* line_start = buffer.data();
+    const char* p = buffer.data();
+
+    const auto add_line = [&](const char* newline) {
+        f(std::string_view{line_start, static_cast<std::size_t>(newline - line_start)});
+        line_start = newline + 1;
+    };
+
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i newlines = _mm_set1_epi8('\n');
+
+    for (; end - p >= 16; p += 16) {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, newlines)));
+
+        for (; mask != 0; mask &= mask - 1)
+            add_line(p + std::countr_zero(mask));
+    }
+#endif
+
+    for (; p < end; ++p)
+        if (*p == '\n')
+            add_line(p);
+
+    if (line_start < end)
+        f(std::string_view{line_start, static_cast<std::size_t>(end - line_start)});
+}
+
+inline std::vector<std::string_view> split_lines(const std::string_view buffer)
+{
+    std::vector<std::string_view> lines;
+    for_each_line(buffer, [&](const std::string_view line) { lines.push_back(line); });
+    return lines;
+}
+
+// The lines of a corpus as views into one buffer, which is either a memory-mapped file or a copy
+// of in-memory test data.
+class CorpusLines {
+public:
+    explicit CorpusLines(const std::vector<std::string>& lines)
+    {
+        for (const auto& line : lines)
+            buffer_ += line + '\n';
+
+        lines_ = split_lines(buffer_);
+        data_ = buffer_;
+    }
+
+    // A missing file gives an empty corpus, same as load_logfile().
+    explicit CorpusLines(const std::filesystem::path& filename)
+    {
+        if (!std::filesystem::exists(filename))
+            return;
+
+        file_ = std::make_unique<MappedFile>(filename);
+        lines_ = split_lines(file_->data());
+        data_ = file_->data();
+    }
+
+    CorpusLines(const CorpusLines&) = delete;
+    CorpusLines& operator=(const CorpusLines&) = delete;
+
+    const std::vector<std::string_view>& lines() const { return lines_; }
+
+    // Size of the whole corpus (the mapped file size) including line breaks, for SetBytesProcessed().
+    // All benchmarks which scan a corpus report this, so that their bytes/s can be compared.
+    std::size_t bytes() const { return data_.size(); }
+
+    // Size of the lines [begin, end) including the line breaks after them, the sizes of adjacent
+    // ranges add up to bytes().
+    std::size_t bytes(const std::size_t begin, const std::size_t end) const { return offset(end) - offset(begin); }
+
+private:
+    std::string buffer_;
+    std::unique_ptr<MappedFile> file_;
+    std::vector<std::string_view> lines_;
+    std::string_view data_;
+
+    std::size_t offset(const std::size_t line) const { return line < lines_.size() ? static_cast<std::size_t>(lines_[line].data() - data_.data()) : data_.size(); }
+};
+
+inline CorpusLines load_logfile_mapped() { return CorpusLines{logfile_path()}; }
+
+// Patterns for classifying log lines by many patterns at once. Every pattern matches a whole
+// "RQST END" line like regex2 whose process id starts with the pattern number (1 .. count), so they are all
+// different but share the same structure.
+inline std::vector<std::string> make_multi_patterns(const std::size_t count)
+{
+    std::vector<std::string> patterns;
+
+    for (std::size_t i = 0; i < count; ++i)
+        patterns.push_back(R"(\[[^ ]{8} \| [^\]]{19}\] \((?:[^,]+, )?()" + std::to_string(i + 1) + R"(\d*)\) [^ ]+ \[[^\]]+\] RQST END .*)");
+
+    return patterns;
+}
+
+// Larger patterns for the compile benchmarks: the patterns of make_multi_patterns() as alternatives.
+inline std::string make_alternation_pattern(const std::size_t count)
+{
+    std::string pattern;
+
+    for (const auto& alternative : make_multi_patterns(count))
+        pattern += (pattern.empty() ? "" : "|") + alternative;
+
+    return pattern;
+}
+
+inline const std::string alternation_pattern_10 = make_alternation_pattern(10);
+inline const std::string alternation_pattern_100 = make_alternation_pattern(100);
+
+// FNV-1a, unlike std::hash stable across runs and standard libraries.
+inline std::uint64_t fnv1a(const std::string_view data)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for (const char c : data)
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+
+    return hash;
+}
+
+// On-disk cache of compiled patterns with one file per (engine, pattern, flags) key. The file
+// name is a hash of the key. Every file starts with the full key, so that a hash collision is a
+// miss and not a wrong pattern, followed by the size and the checksum of the data, so that a
+// truncated or corrupt file is a miss as well. Engines serialize and deserialize their compiled
+// patterns themselves and store the result as an opaque blob.
+class PatternCache {
+public:
+    explicit PatternCache(std::filesystem::path directory) : directory_{std::move(directory)}
+    {
+        std::filesystem::create_directories(directory_);
+    }
+
+    std::optional<std::string> load(const std::string_view engine, const std::string_view pattern, const std::uint64_t flags) const
+    {
+        const std::string key = make_key(engine, pattern, flags);
+        std::ifstream in(path_for(key), std::ios::binary);
+
+        if (!in)
+            return std::nullopt;
+
+        std::string contents{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+
+        if (contents.size() < key.size() + data_header_size || !contents.starts_with(key))
+            return std::nullopt;
+
+        std::string data = contents.substr(key.size() + data_header_size);
+
+        if (contents.compare(key.size(), data_header_size, make_data_header(data)) != 0)
+            return std::nullopt;
+
+        ++hits_;
+        return data;
+    }
+
+    void store(const std::string_view engine, const std::string_view pattern, const std::uint64_t flags, const std::string_view data) const
+    {
+        const std::string key = make_key(engine, pattern, flags);
+        const std::string data_header = make_data_header(data);
+        const std::filesystem::path filename = path_for(key);
+        const std::filesystem::path temporary = unique_temporary_path(filename);
+
+        {
+            std::ofstream out(temporary, std::ios::binary);
+
+            out.write(key.data(), static_cast<std::streamsize>(key.size()));
+            out.write(data_header.data(), static_cast<std::streamsize>(data_header.size()));
+            out.write(data.data(), static_cast<std::streamsize>(data.size()));
+
+            if (!out) {
+                out.close();
+                std::filesystem::remove(temporary);
+                throw std::runtime_error{"unable to write pattern cache entry to " + directory_.string()};
+            }
+        }
+
+        std::filesystem::rename(temporary, filename);
+    }
+
+    void clear() const
+    {
+        for (const auto& entry : std::filesystem::directory_iterator{directory_})
+            std::filesystem::remove(entry.path());
+    }
+
+    std::size_t hits() const { return hits_; }
+
+private:
+    static constexpr std::size_t data_header_size = 32;
+
+    std::filesystem::path directory_;
+    mutable std::size_t hits_ = 0;
+
+    static std::string make_key(const std::string_view engine, const std::string_view pattern, const std::uint64_t flags)
+    {
+        std::string key{engine};
+        key += '\0';
+        key += std::to_string(flags);
+        key += '\0';
+        key += std::to_string(pattern.size());
+        key += '\0';
+        key += pattern;
+        return key;
+    }
+
+    // size and checksum of the data as 16 hex digits each
+    static std::string make_data_header(const std::string_view data)
+    {
+        char header[data_header_size + 1];
+        std::snprintf(header, sizeof(header), "%016llx%016llx", static_cast<unsigned long long>(data.size()), static_cast<unsigned long long>(fnv1a(data)));
+
+        return {header, data_header_size};
+    }
+
+    std::filesystem::path path_for(const std::string_view key) const
+    {
+        char name[17];
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(fnv1a(key)));
+
+        return directory_ / name;
+    }
+};
+
+// Every regex engine gets wrapped in a Matcher. It compiles the pattern once in its constructor
+// and keeps all state needed for matching (match data, JIT stack, capture storage) between calls.
+// match() returns the summed length of all captured groups, or 0 if the line does not match.
+// Copies share the compiled pattern but not the match state, one copy per thread can match in parallel.
+template <typename T>
+concept Matcher = std::constructible_from<T, const char*> && std::copy_constructible<T> && requires(T& matcher, const std::string_view line) {
+    { T::name } -> std::convertible_to<std::string>;
+    { matcher.match(line) } -> std::same_as<std::size_t>;
+};
+
+struct Pattern {
+    const char* name;
+    const char* regex;
+};
+
+// Returns the longest literal string which every match of the pattern has to contain, or an empty
+// string if there is none that can be found without a full parse. Groups, character classes and
+// escapes like \d end a literal, quantifiers which allow zero repetitions also remove the
+// preceding character. Alternatives, inline flags at the top level, escapes with operands (\x41,
+// \012, \p{..}, \Q..\E, ...) and unterminated braces give up.
+inline std::string required_literal(const std::string_view pattern)
+{
+    // escapes which stand for themselves or for one character, class or assertion without operands
+    constexpr std::string_view simple_escapes = "dDwWsSbBhHvVRAzZGKXntrfea";
+
+    // \Q..\E quotes everything up to \E, also inside groups and classes which get skipped below
+    if (pattern.find("\\Q") != std::string_view::npos)
+        return {};
+
+    std::string longest;
+    std::string current;
+    bool last_is_literal = false;
+
+    const auto end_literal = [&] {
+        if (current.size() > longest.size())
+            longest = current;
+
+        current.clear();
+        last_is_literal = false;
+    };
+
+    const auto skip_class = [&](std::size_t i) {  // i at '[', returns the index of the closing ']'
+        ++i;
+
+        if (i < pattern.size() && pattern[i] == '^')
+            ++i;
+
+        if (i < pattern.size() && pattern[i] == ']')
+            ++i;
+
+        for (; i < pattern.size() && pattern[i] != ']'; ++i)
+            if (pattern[i] == '\\')
+                ++i;
+
+        return i;
+    };
+
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        const char c = pattern[i];
+
+        if (c == '\\' && i + 1 < pattern.size()) {
+            const char escaped = pattern[++i];
+
+            if (std::isalnum(static_cast<unsigned char>(escaped))) {
+                if (simple_escapes.find(escaped) == std::string_view::npos)
+                    return {};
+
+                end_literal();
+            } else {
+                current += escaped;
+                last_is_literal = true;
+            }
+        } else if (c == '[') {
+            i = skip_class(i);
+            end_literal();
+        } else if (c == '(') {
+            if (i + 2 < pattern.size() && pattern[i + 1] == '?' && std::isalpha(static_cast<unsigned char>(pattern[i + 2])))
+                return {};
+
+            for (int depth = 0; i < pattern.size(); ++i) {
+                if (pattern[i] == '\\')
+                    ++i;
+                else if (pattern[i] == '[')
+                    i = skip_class(i);
+                else if (pattern[i] == '(')
+                    ++depth;
+                else if (pattern[i] == ')' && --depth == 0)
+                    break;
+            }
+
+            end_literal();
+        } else if (c == '|') {
+            return {};
+        } else if (c == '*' || c == '?' || c == '+' || c == '{') {
+            const bool optional = c == '*' || c == '?' || (c == '{' && i + 1 < pattern.size() && (pattern[i + 1] == '0' || pattern[i + 1] == ','));
+
+            if (optional && last_is_literal)
+                current.pop_back();
+
+            if (c == '{') {
+                i = pattern.find('}', i);
+
+                if (i == std::string_view::npos)
+                    return {};
+            }
+
+            if (i + 1 < pattern.size() && (pattern[i + 1] == '?' || pattern[i + 1] == '+'))
+                ++i;
+
+            end_literal();
+        } else if (c == '.' || c == '^' || c == '$') {
+            end_literal();
+        } else {
+            current += c;
+            last_is_literal = true;
+        }
+    }
+
+    end_literal();
+    return longest;
+}
+
+// Whether the literal occurs in the text. With SSE2 every 16 positions get checked at once by
+// comparing the first and the last character of the literal, only candidates matching both get
+// compared completely.
+inline bool contains_literal(const std::string_view text, const std::string_view literal)
+{
+#if defined(__SSE2__) || defined(_M_X64)
+    if (literal.size() >= 2 && literal.size() <= text.size()) {
+        const __m128i first = _mm_set1_epi8(literal.front());
+        const __m128i last = _mm_set1_epi8(literal.back());
+        const std::size_t last_offset = literal.size() - 1;
+        std::size_t i = 0;
+
+        for (; i + last_offset + 16 <= text.size(); i += 16) {
+            const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+            const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i + last_offset));
+            auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last))));
+
+            for (; mask != 0; mask &= mask - 1) {
+                const std::size_t pos = i + static_cast<std::size_t>(std::countr_zero(mask));
+
+                if (std::memcmp(text.data() + pos + 1, literal.data() + 1, literal.size() - 2) == 0)
+                    return true;
+            }
+        }
+
+        return text.substr(i).find(literal) != std::string_view::npos;
+    }
+#endif
+
+    return text.find(literal) != std::string_view::npos;
+}
+
+// Wraps a Matcher and rejects lines which do not contain the required literal of the pattern
+// before they get to the regex engine.
+template <Matcher M>
+class LiteralFilter {
+public:
+    static constexpr auto name_buffer = [] {
+        constexpr std::string_view prefix = "LiteralFilter_";
+        constexpr std::string_view matcher_name = M::name;
+        std::array<char, prefix.size() + matcher_name.size() + 1> buffer{};
+        std::ranges::copy(matcher_name, std::ranges::copy(prefix, buffer.begin()).out);
+        return buffer;
+    }();
+
+    // Built at compile time, benchmarks get registered during static initialization.
+    static constexpr const char* name = name_buffer.data();
+
+    explicit LiteralFilter(const char* pattern) : matcher_{pattern}, literal_{required_literal(pattern)} {}
+
+    std::size_t match(const std::string_view line)
+    {
+        ++checked_lines_;
+
+        if (!contains_literal(line, literal_)) {
+            ++rejected_lines_;
+            return 0;
+        }
+
+        return matcher_.match(line);
+    }
+
+    std::size_t checked_lines() const { return checked_lines_; }
+    std::size_t rejected_lines() const { return rejected_lines_; }
+
+private:
+    M matcher_;
+    std::string literal_;
+    std::size_t checked_lines_ = 0;
+    std::size_t rejected_lines_ = 0;
+};
+
+// Position of the next occurrence of c at or after pos, or the size of the text if there is none.
+inline std::size_t find_byte(const std::string_view text, std::size_t pos, const char c)
+{
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i needle = _mm_set1_epi8(c);
+
+    for (; pos + 16 <= text.size(); pos += 16) {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + pos));
+        const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, needle)));
+
+        if (mask != 0)
+            return pos + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+#endif
+
+    for (; pos < text.size(); ++pos)
+        if (text[pos] == c)
+            return pos;
+
+    return text.size();
+}
+
+// The four fields captured by regex2.
+struct LogFields {
+    std::string_view request_id;
+    std::string_view timestamp;
+    std::string_view handler;
+    std::string_view ms;
+};
+
+// Parses a log line at the '[' at position start the way PCRE matches regex2 there. Only the
+// optional "<address>, " part needs backtracking, all other fields end at the first delimiter.
+inline std::optional<LogFields> parse_log_line_at(const std::string_view line, const std::size_t start)
+{
+    const auto literal_at = [&](const std::size_t pos, const std::string_view literal) { return pos <= line.size() && line.substr(pos).starts_with(literal); };
+    const auto is_digit = [](const char c) { return c >= '0' && c <= '9'; };
+
+    const auto skip_digits = [&](std::size_t pos) {
+        while (pos < line.size() && is_digit(line[pos]))
+            ++pos;
+
+        return pos;
+    };
+
+    // everything after "(<address>, ", starting with the process id
+    const auto parse_rest = [&](const std::size_t pid_start) -> std::optional<LogFields> {
+        const std::size_t pid_end = skip_digits(pid_start);
+
+        if (pid_end == pid_start || !literal_at(pid_end, ") "))
+            return std::nullopt;
+
+        const std::size_t path_start = pid_end + 2;
+        const std::size_t path_end = find_byte(line, path_start, ' ');
+
+        if (path_end == path_start || !literal_at(path_end, " ["))
+            return std::nullopt;
+
+        const std::size_t handler_start = path_end + 2;
+        const std::size_t handler_end = find_byte(line, handler_start, ']');
+
+        if (handler_end == handler_start || !literal_at(handler_end, "] RQST END   ["))
+            return std::nullopt;
+
+        const std::size_t status_start = handler_end + 14;
+        const std::size_t status_end = find_byte(line, status_start, ']');
+
+        if (status_end == status_start || status_end == line.size())
+            return std::nullopt;
+
+        std::size_t ms_start = status_end + 1;
+
+        while (ms_start < line.size() && line[ms_start] == ' ')
+            ++ms_start;
+
+        const std::size_t ms_end = skip_digits(ms_start);
+
+        if (ms_end == ms_start || !literal_at(ms_end, " ms"))
+            return std::nullopt;
+
+        return LogFields{line.substr(start + 1, 8), line.substr(start + 12, 19), line.substr(handler_start, handler_end - handler_start), line.substr(ms_start, ms_end - ms_start)};
+    };
+
+    if (start + 34 > line.size() || !literal_at(start + 9, " | ") || !literal_at(start + 31, "] ("))
+        return std::nullopt;
+
+    if (find_byte(line.substr(0, start + 9), start + 1, ' ') != start + 9 || find_byte(line.substr(0, start + 31), start + 12, ']') != start + 31)
+        return std::nullopt;
+
+    const std::size_t address_start = start + 34;
+    const std::size_t comma = find_byte(line, address_start, ',');
+
+    if (comma > address_start && literal_at(comma, ", "))
+        if (auto fields = parse_rest(comma + 2))
+            return fields;
+
+    return parse_rest(address_start);
+}
+
+// Finds the leftmost match of the regex2 log line layout, like an unanchored regex search.
+inline std::optional<LogFields> parse_log_line(const std::string_view line)
+{
+    for (std::size_t start = find_byte(line, 0, '['); start < line.size(); start = find_byte(line, start + 1, '['))
+        if (auto fields = parse_log_line_at(line, start))
+            return fields;
+
+    return std::nullopt;
+}
+
+// Hand-written parser for the log line layout of regex2, without a regex engine.
+class HandParser {
+public:
+    static constexpr const char* name = "HandParser";
+
+    explicit HandParser(const char* pattern)
+    {
+        if (std::string_view{pattern} != regex2)
+            throw std::runtime_error{"HandParser only parses the layout of regex2"};
+    }
+
+    std::size_t match(const std::string_view line)
+    {
+        const auto fields = parse_log_line(line);
+        return fields ? fields->request_id.size() + fields->timestamp.size() + fields->handler.size() + fields->ms.size() : 0;
+    }
+};
+
+// Matchers which reject lines before matching them report the fraction of rejected lines.
+template <std::ranges::input_range R>
+void set_rejected_counter(benchmark::State& state, R&& matchers)
+{
+    using M = std::remove_cvref_t<std::ranges::range_reference_t<R>>;
+
+    if constexpr (requires(const M& matcher) { matcher.rejected_lines(); matcher.checked_lines(); }) {
+        std::size_t checked = 0;
+        std::size_t rejected = 0;
+
+        for (const M& matcher : matchers) {
+            checked += matcher.checked_lines();
+            rejected += matcher.rejected_lines();
+        }
+
+        state.counters["rejected"] = checked > 0 ? static_cast<double>(rejected) / static_cast<double>(checked) : 0.0;
+    }
+}
+
+// Large corpora get scanned in parallel with a varying number of threads.
+struct Corpus {
+    const char* name;
+    CorpusLines (*load)();
+    bool parallel;
+};
+
+inline const Corpus corpora[] = {
+    {"OneLine", [] { return CorpusLines{std::vector<std::string>{one_line}}; }, false},
+    {"AllLines", [] { return CorpusLines{all_lines}; }, false},
+    {"Logfile", load_logfile_mapped, true},
+};
+
+// Mutable match state (match data, JIT stack, scratch space) for a compiled pattern shared by all
+// threads. Every thread creates its own State with the factory on first use and afterwards gets
+// it back without any locking. The states of a thread live until the thread exits. Not copyable,
+// copies would share the states.
+template <typename State>
+class PerThreadState {
+public:
+    explicit PerThreadState(std::function<State()> factory) : factory_{std::move(factory)} {}
+
+    PerThreadState(const PerThreadState&) = delete;
+    PerThreadState& operator=(const PerThreadState&) = delete;
+
+    State& get() const
+    {
+        thread_local std::unordered_map<std::size_t, State> states;
+        thread_local std::size_t last_id = 0;
+        thread_local State* last_state = nullptr;
+
+        if (last_state && last_id == id_)
+            return *last_state;
+
+        auto it = states.find(id_);
+
+        if (it == states.end())
+            it = states.emplace(id_, factory_()).first;
+
+        last_id = id_;
+        last_state = &it->second;
+
+        return it->second;
+    }
+
+private:
+    static inline std::atomic<std::size_t> next_id_{1};
+
+    std::function<State()> factory_;
+    std::size_t id_ = next_id_.fetch_add(1);
+};
+
+template <Matcher M>
+void BM_Match(benchmark::State& state, const Pattern& pattern, const Corpus& corpus)
+{
+    std::size_t length = 0;
+
+    const CorpusLines corpus_lines = corpus.load();
+    const auto& lines = corpus_lines.lines();
+    M matcher{pattern.regex};
+
+    for (auto _ : state)
+        for (const auto& line : lines)
+            length += matcher.match(line);
+
+    state.counters["length"] = static_cast<double>(length);
+    set_rejected_counter(state, std::span<const M>{&matcher, 1});
+}
+
+// Splits the corpus into one contiguous part per thread, every thread matches its part with its
+// own copy of the matcher.
+template <Matcher M>
+void BM_MatchParallel(benchmark::State& state, const Pattern& pattern, const Corpus& corpus)
+{
+    std::size_t length = 0;
+
+    const CorpusLines corpus_lines = corpus.load();
+    const auto& lines = corpus_lines.lines();
+    const int num_threads = static_cast<int>(state.range(0));
+
+    // every matcher gets its own cache lines, otherwise the threads update the match state and
+    // counters of their neighbours' matchers on every line
+    struct alignas(64) MatcherSlot {
+        M matcher;
+    };
+
+    const MatcherSlot prototype{M{pattern.regex}};
+    std::vector<MatcherSlot> matchers(static_cast<std::size_t>(num_threads), prototype);
+    std::vector<std::size_t> part_lengths(static_cast<std::size_t>(num_threads));
+    ThreadPool pool{num_threads};
+
+    const auto match_part = [&](const int index) {
+        const std::size_t part = static_cast<std::size_t>(index);
+        const std::size_t begin = lines.size() * part / matchers.size();
+        const std::size_t end = lines.size() * (part + 1) / matchers.size();
+        std::size_t part_length = 0;
+
+        for (std::size_t i = begin; i < end; ++i)
+            part_length += matchers[part].matcher.match(lines[i]);
+
+        part_lengths[part] = part_length;
+    };
+
+    for (auto _ : state) {
+        pool.run(match_part);
+
+        for (const std::size_t part_length : part_lengths)
+            length += part_length;
+    }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(corpus_lines.bytes()));
+    state.counters["length"] = static_cast<double>(length);
+    set_rejected_counter(state, matchers | std::views::transform(&MatcherSlot::matcher));
+}
+
+// All benchmark threads match the log file with one matcher for regex2, each thread its own part
+// of the lines. The matcher gets shared by all threads and keeps their match state in a
+// PerThreadState, so match() is const and each thread pays for creating its state only once.
+template <typename M>
+void BM_Logfile_ThreadLocal(benchmark::State& state)
+{
+    static const M matcher{regex2};
+    static const CorpusLines corpus_lines = load_logfile_mapped();
+
+    const auto& lines = corpus_lines.lines();
+    const auto threads = static_cast<std::size_t>(state.threads());
+    const auto thread = static_cast<std::size_t>(state.thread_index());
+    const std::size_t begin = lines.size() * thread / threads;
+    const std::size_t end = lines.size() * (thread + 1) / threads;
+
+    std::size_t length = 0;
+
+    for (auto _ : state)
+        for (std::size_t i = begin; i < end; ++i)
+            length += matcher.match(lines[i]);
+
+    // the parts of all threads add up to the whole corpus
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(corpus_lines.bytes(begin, end)));
+    state.counters["length"] = static_cast<double>(length);
+}
+
+template <typename... Matchers>
+bool register_thread_local_benchmarks()
+{
+    (benchmark::RegisterBenchmark(("BM_Logfile_ThreadLocal_" + std::string{Matchers::name} + "/2").c_str(), BM_Logfile_ThreadLocal<Matchers>)
+         ->Threads(1)->Threads(2)->Threads(4)->Threads(8)->Unit(benchmark::kMicrosecond)->UseRealTime(), ...);
+
+    return true;
+}
+
+// Loads the log file and matches all lines, once with std::getline into one std::string per
+// line (load_logfile) and once from the memory-mapped file with views into it (load_logfile_mapped).
+template <Matcher M>
+void BM_LoadLogfile_Getline(benchmark::State& state, const Pattern& pattern)
+{
+    std::size_t length = 0;
+
+    M matcher{pattern.regex};
+    const std::size_t allocations_before = allocation_count;
+
+    for (auto _ : state)
+        for (const auto& line : load_logfile())
+            length += matcher.match(line);
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(std::filesystem::file_size(logfile_path())));
+    state.counters["length"] = static_cast<double>(length);
+    state.counters["allocations"] = benchmark::Counter(static_cast<double>(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+}
+
+template <Matcher M>
+void BM_LoadLogfile_Mapped(benchmark::State& state, const Pattern& pattern)
+{
+    std::size_t length = 0;
+    std::size_t bytes = 0;
+
+    M matcher{pattern.regex};
+    const std::size_t allocations_before = allocation_count;
+
+    for (auto _ : state) {
+        const CorpusLines corpus_lines = load_logfile_mapped();
+
+        for (const auto& line : corpus_lines.lines())
+            length += matcher.match(line);
+
+        bytes += corpus_lines.bytes();
+    }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+    state.counters["length"] = static_cast<double>(length);
+    state.counters["allocations"] = benchmark::Counter(static_cast<double>(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+}
+
+template <Matcher... Matchers>
+bool register_load_benchmarks(const Pattern pattern)
+{
+    (benchmark::RegisterBenchmark(("BM_LoadLogfile_Getline_" + std::string{Matchers::name} + "/" + pattern.name).c_str(),
+                                  [pattern](benchmark::State& state) { BM_LoadLogfile_Getline<Matchers>(state, pattern); })->Unit(benchmark::kMillisecond), ...);
+    (benchmark::RegisterBenchmark(("BM_LoadLogfile_Mapped_" + std::string{Matchers::name} + "/" + pattern.name).c_str(),
+                                  [pattern](benchmark::State& state) { BM_LoadLogfile_Mapped<Matchers>(state, pattern); })->Unit(benchmark::kMillisecond), ...);
+
+    return true;
+}
+
+// Compiles the pattern once per iteration, like a service compiling a user-supplied filter per
+// request, including the match state and the destruction of the Matcher. Engines written in C++
+// allocate through operator new and get counted by the allocations and allocated_bytes counters,
+// the C libraries allocate with malloc and report the size of the compiled pattern instead through
+// an optional compiled_size() member.
+template <Matcher M>
+void BM_Compile(benchmark::State& state, const Pattern& pattern)
+{
+    constexpr bool has_compiled_size = requires(const M& matcher) { matcher.compiled_size(); };
+
+    std::size_t compiled_size = 0;
+    const std::size_t allocations_before = allocation_count;
+    const std::size_t allocated_bytes_before = allocated_bytes;
+
+    for (auto _ : state) {
+        M matcher{pattern.regex};
+        benchmark::DoNotOptimize(&matcher);
+
+        if constexpr (has_compiled_size)
+            compiled_size = matcher.compiled_size();
+    }
+
+    state.counters["allocations"] = benchmark::Counter(static_cast<double>(allocation_count - allocations_before), benchmark::Counter::kAvgIterations);
+    state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(allocated_bytes - allocated_bytes_before), benchmark::Counter::kAvgIterations);
+
+    if constexpr (has_compiled_size)
+        state.counters["compiled_size"] = static_cast<double>(compiled_size);
+}
+
+// Registers BM_Compile_<Matcher::name>/<Pattern::name> for regex1 .. regex3 and the alternations
+// of 10 and 100 log line patterns.
+template <Matcher... Matchers>
+bool register_compile_benchmarks()
+{
+    const Pattern patterns[] = {{"1", regex1}, {"2", regex2}, {"3", regex3}, {"Alt10", alternation_pattern_10.c_str()}, {"Alt100", alternation_pattern_100.c_str()}};
+
+    ([&] {
+        for (const Pattern& pattern : patterns)
+            benchmark::RegisterBenchmark(("BM_Compile_" + std::string{Matchers::name} + "/" + pattern.name).c_str(),
+                                         [pattern](benchmark::State& state) { BM_Compile<Matchers>(state, pattern); })->Unit(benchmark::kMicrosecond);
+    }(), ...);
+
+    return true;
+}
+
+// Startup of a service with state.range(0) patterns: cold compiles every pattern and stores it
+// in the empty cache, warm deserializes every pattern from the cache filled before. Engines have
+// a name and a compile(cache, pattern) function which returns an owner of the compiled pattern.
+template <typename Engine>
+void BM_PatternCache(benchmark::State& state, const bool warm)
+{
+    const auto patterns = make_multi_patterns(static_cast<std::size_t>(state.range(0)));
+    const PatternCache cache{std::filesystem::temp_directory_path() / "regex_benchmark_cache" / Engine::name};
+
+    cache.clear();
+
+    if (warm)
+        for (const auto& pattern : patterns)
+            Engine::compile(cache, pattern);
+
+    const std::size_t hits_before = cache.hits();
+
+    for (auto _ : state) {
+        if (!warm) {
+            state.PauseTiming();
+            cache.clear();
+            state.ResumeTiming();
+        }
+
+        std::vector<decltype(Engine::compile(cache, patterns.front()))> compiled;
+        compiled.reserve(patterns.size());
+
+        for (const auto& pattern : patterns)
+            compiled.push_back(Engine::compile(cache, pattern));
+
+        benchmark::DoNotOptimize(compiled.data());
+    }
+
+    state.counters["hits"] = benchmark::Counter(static_cast<double>(cache.hits() - hits_before), benchmark::Counter::kAvgIterations);
+}
+
+template <typename... Engines>
+bool register_pattern_cache_benchmarks()
+{
+    (benchmark::RegisterBenchmark(("BM_PatternCache_Cold_" + std::string{Engines::name}).c_str(), [](benchmark::State& state) { BM_PatternCache<Engines>(state, false); })
+         ->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond), ...);
+    (benchmark::RegisterBenchmark(("BM_PatternCache_Warm_" + std::string{Engines::name}).c_str(), [](benchmark::State& state) { BM_PatternCache<Engines>(state, true); })
+         ->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond), ...);
+
+    return true;
+}
+
+// Classifies every log line by state.range(0) patterns, one after another. Counts the matched
+// (line, pattern) pairs.
+template <Matcher M>
+void BM_Logfile_MultiPattern(benchmark::State& state)
+{
+    std::size_t matches = 0;
+
+    const CorpusLines corpus_lines = load_logfile_mapped();
+    const auto patterns = make_multi_patterns(static_cast<std::size_t>(state.range(0)));
+    std::vector<M> matchers;
+
+    for (const auto& pattern : patterns)
+        matchers.emplace_back(pattern.c_str());
+
+    for (auto _ : state)
+        for (const auto& line : corpus_lines.lines())
+            for (auto& matcher : matchers)
+                if (matcher.match(line) > 0)
+                    ++matches;
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(corpus_lines.bytes()));
+    state.counters["matches"] = benchmark::Counter(static_cast<double>(matches), benchmark::Counter::kAvgIterations);
+}
+
+template <Matcher... Matchers>
+bool register_multi_pattern_benchmarks()
+{
+    (benchmark::RegisterBenchmark(("BM_Logfile_MultiPattern_" + std::string{Matchers::name}).c_str(), BM_Logfile_MultiPattern<Matchers>)
+         ->Arg(1)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond), ...);
+
+    return true;
+}
+
+// Matches all lines of a synthetic log file of state.range(0) MB in which state.range(1) percent
+// of the lines match. The file gets mapped and scanned without a vector of all lines, so that
+// sizes up to several GB work as well.
+template <Matcher M>
+void BM_Synthetic(benchmark::State& state, const Pattern& pattern)
+{
+    const auto size = static_cast<std::uint64_t>(state.range(0)) << 20;
+    const double match_ratio = static_cast<double>(state.range(1)) / 100.0;
+
+    const MappedFile file{synthetic_logfile(size, match_ratio)};
+    M matcher{pattern.regex};
+    std::size_t matches = 0;
+
+    for (auto _ : state)
+        for_each_line(file.data(), [&](const std::string_view line) {
+            if (matcher.match(line) > 0)
+                ++matches;
+        });
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(file.data().size()));
+    state.counters["matches"] = benchmark::Counter(static_cast<double>(matches), benchmark::Counter::kAvgIterations);
+}
+
+// Registers BM_Synthetic_<Matcher::name>/<Pattern::name> for 1 MB and 64 MB with 10, 50 and 90
+// percent matching lines. Other sizes up to 10 GB only need another Args() line.
+template <Matcher... Matchers>
+bool register_synthetic_benchmarks(const Pattern pattern)
+{
+    (benchmark::RegisterBenchmark(("BM_Synthetic_" + std::string{Matchers::name} + "/" + pattern.name).c_str(),
+                                  [pattern](benchmark::State& state) { BM_Synthetic<Matchers>(state, pattern); })
+         ->ArgNames({"MB", "match_percent"})->ArgsProduct({{1, 64}, {10, 50, 90}})->Unit(benchmark::kMillisecond), ...);
+
+    return true;
+}
+
+// Registers BM_<Corpus>_<Matcher::name>/<Pattern::name> for every combination of corpus, matcher
+// and pattern, ordered by corpus first. Parallel corpora get an additional threads argument.
+template <Matcher... Matchers>
+bool register_match_benchmarks(const std::initializer_list<Pattern> patterns)
+{
+    for (const Corpus& corpus : corpora) {
+        ([&] {
+            for (const Pattern& pattern : patterns) {
+                const std::string name = "BM_" + std::string{corpus.name} + "_" + Matchers::name + "/" + pattern.name;
+
+                if (corpus.parallel)
+                    benchmark::RegisterBenchmark(name.c_str(), [pattern, &corpus](benchmark::State& state) { BM_MatchParallel<Matchers>(state, pattern, corpus); })
+                        ->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMicrosecond)->UseRealTime();
+                else
+                    benchmark::RegisterBenchmark(name.c_str(), [pattern, &corpus](benchmark::State& state) { BM_Match<Matchers>(state, pattern, corpus); })
+                        ->Unit(benchmark::kMicrosecond);
+            }
+        }(), ...);
+    }
+
+    return true;
+}
@@ -1,25 +1,20 @@
+#include <algorithm>
 #include <benchmark/benchmark.h>
-#include <fstream>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <hs/hs.h>
 
-const std::string one_line{"[00180D0F | 2009-09-15 09:34:48] (127.0.0.1:39170, 879) /cmd.php [co_search.browse] RQST END   [normal]   799 ms"};
-const std::vector<std::string> all_lines{
-    "[05821BE4 | 2019-05-13 12:28:56] (13036) http://test.site/projects/cmd.php [co_project.view] RQST START",
-    "[05821BE4 | 2019-05-13 12:28:56] (13036) http://test.site/projects/cmd.php [co_project.view] RQST END   [normal]   402 ms",
-    "[05671FA1 | 2019-04-17 14:08:03] (62931) http://test.site/projects/cmd.php [co_project.view] RQST START",
-    "[05671FA1 | 2019-04-17 14:08:03] (62931) http://test.site/projects/cmd.php [co_project.view] RQST END   [normal]   237 ms",
-    "[05822AE4 | 2019-06-17 06:59:03] (15828) http://test.site/cmd.php [co_project.dialog_doc_details] RQST START",
-    "[05822AE4 | 2019-06-17 06:59:03] (15828) http://test.site/cmd.php [co_project.dialog_doc_details] RQST END   [normal]   318 ms",
-    "[00180D0F | 2009-09-15 09:34:47] (127.0.0.1:39170, 879) /cmd.php [co_search.browse] RQST START",
-    "[00180D0F | 2009-09-15 09:34:48] (127.0.0.1:39170, 879) /cmd.php [co_search.browse] RQST END   [normal]   799 ms",
-    "[00180D0D | 2009-09-15 09:34:19] (127.0.0.1:39169, 23727) /browse/ RQST START",
-    "[00180D0D | 2009-09-15 09:34:19] (127.0.0.1:39169, 23727) /browse/ RQST END   [normal]    35 ms",
-    "[001F86EA | 2009-11-02 16:05:50] (127.0.0.1:1789, 10994) /cmd.php [co_doc.details] RQST START",
-    "[001F86EA | 2009-11-02 16:05:50] (127.0.0.1:1789, 10994) /cmd.php [co_doc.details] RQST END   [normal]    84 ms"};
-
-const char* regex1 = R"(\[(.+) \| ([^\]]+)\] \((.+, )?(\d+)\) (.+) \[(.+)\] RQST END   \[(.+)\] *(\d+) ms)";
-const char* regex2 = R"(\[([^ ]{8}) \| ([^\]]{19})\] \((?:[^,]+, )?\d+\) [^ ]+ \[([^\]]+)\] RQST END   \[[^\]]+\] *(\d+) ms)";
+#include "regex_benchmark.h"
 
 static int match_found_handler(unsigned int, unsigned long long from, unsigned long long to, unsigned int, void* ctx)
 {
@@ -28,35 +23,201 @@ static int match_found_handler(unsigned int, unsigned long long from, unsigned l
     return 0;
 }
 
-std::size_t check_hyperscan(const std::string& line, const hs_database_t* database, hs_scratch_t* scratch)
+std::size_t check_hyperscan(const std::string_view line, const hs_database_t* database, hs_scratch_t* scratch)
 {
     std::size_t length = 0;
 
-    if (hs_scan(database, line.c_str(), static_cast<unsigned int>(line.length()), 0, scratch, match_found_handler, &length) != HS_SUCCESS)
+    if (hs_scan(database, line.data(), static_cast<unsigned int>(line.size()), 0, scratch, match_found_handler, &length) != HS_SUCCESS)
         throw std::runtime_error{"Hyperscan scan error"};
 
     return length;
 }
 
-std::vector<std::string> load_logfile()
+std::tuple<hs_database_t*, hs_scratch_t*> init_hyperscan(const char* pattern)
 {
-    std::ifstream in("../logfile.txt");
-    std::vector<std::string> lines;
-    std::string line;
+    hs_database_t* database;
+    hs_scratch_t* scratch = nullptr;
+    hs_compile_error_t* compile_err;
 
-    while (std::getline(in, line))
-        lines.push_back(line);
+    if (hs_compile(pattern, HS_FLAG_DOTALL | HS_FLAG_SINGLEMATCH, HS_MODE_BLOCK, nullptr, &database, &compile_err) != HS_SUCCESS)
+        throw std::runtime_error{"Hyperscan unable to compile pattern"};
+
+    if (hs_alloc_scratch(database, &scratch) != HS_SUCCESS)
+        throw std::runtime_error{"Hyperscan unable to allocate scratch space"};
 
-    return lines;
+    return std::make_tuple(database, scratch);
 }
 
-std::tuple<hs_database_t*, hs_scratch_t*> init_hyperscan(const char* pattern)
+// Compiles the pattern like init_hyperscan() or deserializes the database from the cache.
+std::shared_ptr<hs_database_t> compile_hyperscan_cached(const PatternCache& cache, const std::string& pattern)
+{
+    constexpr unsigned int flags = HS_FLAG_DOTALL | HS_FLAG_SINGLEMATCH;
+    constexpr unsigned int mode = HS_MODE_BLOCK;
+    constexpr std::uint64_t key_flags = (std::uint64_t{mode} << 32) | flags;
+
+    hs_database_t* database = nullptr;
+
+    if (const auto data = cache.load("Hyperscan", pattern, key_flags))
+        if (hs_deserialize_database(data->data(), data->size(), &database) != HS_SUCCESS)
+            database = nullptr;
+
+    if (database)
+        return {database, hs_free_database};
+
+    hs_compile_error_t* compile_err;
+
+    if (hs_compile(pattern.c_str(), flags, mode, nullptr, &database, &compile_err) != HS_SUCCESS) {
+        hs_free_compile_error(compile_err);
+        throw std::runtime_error{"Hyperscan unable to compile pattern"};
+    }
+
+    std::shared_ptr<hs_database_t> compiled{database, hs_free_database};
+    char* bytes;
+    std::size_t size;
+
+    if (hs_serialize_database(database, &bytes, &size) != HS_SUCCESS)
+        throw std::runtime_error{"Hyperscan unable to serialize database"};
+
+    const std::unique_ptr<char, decltype(&std::free)> serialized{bytes, std::free};
+    cache.store("Hyperscan", pattern, key_flags, {bytes, size});
+
+    return compiled;
+}
+
+struct HyperscanCacheEngine {
+    static constexpr const char* name = "Hyperscan";
+    static std::shared_ptr<hs_database_t> compile(const PatternCache& cache, const std::string& pattern) { return compile_hyperscan_cached(cache, pattern); }
+};
+
+// Copies share the compiled database and get their own scratch space.
+class HyperscanMatcher {
+public:
+    static constexpr const char* name = "Hyperscan";
+
+    explicit HyperscanMatcher(const char* pattern)
+    {
+        auto [database, scratch] = init_hyperscan(pattern);
+        database_.reset(database, hs_free_database);
+        scratch_ = scratch;
+    }
+
+    HyperscanMatcher(const HyperscanMatcher& other) : database_{other.database_}, scratch_{nullptr}
+    {
+        if (hs_clone_scratch(other.scratch_, &scratch_) != HS_SUCCESS)
+            throw std::runtime_error{"Hyperscan unable to clone scratch space"};
+    }
+
+    HyperscanMatcher& operator=(const HyperscanMatcher&) = delete;
+
+    ~HyperscanMatcher() { hs_free_scratch(scratch_); }
+
+    std::size_t match(const std::string_view line) { return check_hyperscan(line, database_.get(), scratch_); }
+
+    std::size_t compiled_size() const
+    {
+        std::size_t database_size = 0;
+        std::size_t scratch_size = 0;
+
+        hs_database_size(database_.get(), &database_size);
+        hs_scratch_size(scratch_, &scratch_size);
+
+        return database_size + scratch_size;
+    }
+
+private:
+    std::shared_ptr<hs_database_t> database_;
+    hs_scratch_t* scratch_;
+};
+
+// Thread-safe variant of HyperscanMatcher for BM_Logfile_ThreadLocal: every thread clones its
+// scratch space from the prototype allocated with the database.
+class ThreadLocalHyperscanMatcher {
+public:
+    static constexpr const char* name = "Hyperscan";
+
+    explicit ThreadLocalHyperscanMatcher(const char* pattern)
+    {
+        auto [database, scratch] = init_hyperscan(pattern);
+        database_.reset(database, hs_free_database);
+        prototype_.reset(scratch, hs_free_scratch);
+    }
+
+    std::size_t match(const std::string_view line) const { return check_hyperscan(line, database_.get(), scratch_.get().get()); }
+
+private:
+    using Scratch = std::unique_ptr<hs_scratch_t, decltype(&hs_free_scratch)>;
+
+    std::shared_ptr<hs_database_t> database_;
+    std::shared_ptr<hs_scratch_t> prototype_;
+    PerThreadState<Scratch> scratch_{[this] {
+        hs_scratch_t* scratch = nullptr;
+
+        if (hs_clone_scratch(prototype_.get(), &scratch) != HS_SUCCESS)
+            throw std::runtime_error{"Hyperscan unable to clone scratch space"};
+
+        return Scratch{scratch, hs_free_scratch};
+    }};
+};
+
+// Whole-buffer scanning: instead of one hs_scan call per line, the log gets scanned in one call
+// (block mode) or fed through a stream in fixed-size chunks (stream mode). Patterns are compiled
+// with HS_FLAG_MULTILINE and without HS_FLAG_DOTALL and HS_FLAG_SINGLEMATCH, so that every match
+// stays inside its line and all lines can match. Since a match never spans a line break, its end
+// offset alone identifies the line and start of match tracking (HS_FLAG_SOM_LEFTMOST) is not needed.
+
+// Adds a newline to every negated character class, "[^ ]" becomes "[^\n ]". A "]" right after
+// "[" or "[^" belongs to the class, so "[^]a]" becomes "[^]\na]". Character classes get copied
+// as a whole, a "[" inside of them does not start another class.
+std::string line_local_pattern(const std::string_view pattern)
+{
+    std::string result;
+
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        result += pattern[i];
+
+        if (pattern[i] == '\\' && i + 1 < pattern.size()) {
+            result += pattern[++i];
+        } else if (pattern[i] == '[') {
+            const bool negated = i + 1 < pattern.size() && pattern[i + 1] == '^';
+
+            if (negated)
+                result += pattern[++i];
+
+            if (i + 1 < pattern.size() && pattern[i + 1] == ']')
+                result += pattern[++i];
+
+            if (negated)
+                result += "\\n";
+
+            for (++i; i < pattern.size(); ++i) {
+                result += pattern[i];
+
+                if (pattern[i] == '\\' && i + 1 < pattern.size()) {
+                    result += pattern[++i];
+                } else if (pattern[i] == '[' && i + 1 < pattern.size() && pattern[i + 1] == ':') {
+                    const std::size_t end = pattern.find(":]", i + 2);
+
+                    if (end != std::string_view::npos) {
+                        result.append(pattern.substr(i + 1, end + 1 - i));
+                        i = end + 1;
+                    }
+                } else if (pattern[i] == ']') {
+                    break;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+std::tuple<hs_database_t*, hs_scratch_t*> init_hyperscan_multiline(const char* pattern, const unsigned int mode)
 {
     hs_database_t* database;
     hs_scratch_t* scratch = nullptr;
     hs_compile_error_t* compile_err;
 
-    if (hs_compile(pattern, HS_FLAG_DOTALL | HS_FLAG_SINGLEMATCH, HS_MODE_BLOCK, nullptr, &database, &compile_err) != HS_SUCCESS)
+    if (hs_compile(line_local_pattern(pattern).c_str(), HS_FLAG_MULTILINE, mode, nullptr, &database, &compile_err) != HS_SUCCESS)
         throw std::runtime_error{"Hyperscan unable to compile pattern"};
 
     if (hs_alloc_scratch(database, &scratch) != HS_SUCCESS)
@@ -65,59 +226,311 @@ std::tuple<hs_database_t*, hs_scratch_t*> init_hyperscan(const char* pattern)
     return std::make_tuple(database, scratch);
 }
 
-static void BM_OneLine_Hyperscan(benchmark::State& state, const char* pattern)
+// Sums up the same lengths as check_hyperscan() does per line: the end of the first match in every
+// line, relative to the line start. Matches get reported ordered by their end offset.
+struct LineMatches {
+    const char* data;                         // block mode: the scanned buffer
+    std::deque<unsigned long long> newlines;  // stream mode: offsets of line breaks not yet passed
+    unsigned long long line_start = 0;
+    unsigned long long searched_to = 0;       // block mode: end of the bytes already searched for line breaks
+    unsigned long long matched_line_start = ~0ULL;
+    std::size_t length = 0;
+
+    void add_match(const unsigned long long to)
+    {
+        if (line_start != matched_line_start) {
+            matched_line_start = line_start;
+            length += static_cast<std::size_t>(to - line_start);
+        }
+    }
+};
+
+static int block_match_handler(unsigned int, unsigned long long, unsigned long long to, unsigned int, void* ctx)
+{
+    LineMatches* matches = static_cast<LineMatches*>(ctx);
+
+    // search back for the last line break before the match, but only through bytes not searched
+    // before, so patterns that report many matches per line stay linear
+    for (unsigned long long pos = to; pos > std::max(matches->line_start, matches->searched_to); --pos) {
+        if (matches->data[pos - 1] == '\n') {
+            matches->line_start = pos;
+            break;
+        }
+    }
+
+    matches->searched_to = std::max(matches->searched_to, to);
+
+    matches->add_match(to);
+    return 0;
+}
+
+static int stream_match_handler(unsigned int, unsigned long long, unsigned long long to, unsigned int, void* ctx)
 {
+    LineMatches* matches = static_cast<LineMatches*>(ctx);
+
+    while (!matches->newlines.empty() && matches->newlines.front() < to) {
+        matches->line_start = matches->newlines.front() + 1;
+        matches->newlines.pop_front();
+    }
+
+    matches->add_match(to);
+    return 0;
+}
+
+// hs_scan takes at most 4 GB, larger buffers get split at line breaks.
+std::size_t scan_hyperscan_block(const std::string_view buffer, const hs_database_t* database, hs_scratch_t* scratch)
+{
+    constexpr std::size_t max_block_size = std::numeric_limits<unsigned int>::max();
+    std::size_t offset = 0;
     std::size_t length = 0;
 
-    auto [database, scratch] = init_hyperscan(pattern);
+    while (offset < buffer.size()) {
+        std::size_t size = std::min(buffer.size() - offset, max_block_size);
 
-    for (auto _ : state)
-        length += check_hyperscan(one_line, database, scratch);
+        if (offset + size < buffer.size()) {
+            const std::size_t newline = buffer.rfind('\n', offset + size - 1);
 
-    hs_free_scratch(scratch);
-    hs_free_database(database);
+            if (newline != std::string_view::npos && newline >= offset)
+                size = newline + 1 - offset;
+        }
 
-    state.counters["length"] = length;
+        LineMatches matches{buffer.data() + offset, {}};
+
+        if (hs_scan(database, buffer.data() + offset, static_cast<unsigned int>(size), 0, scratch, block_match_handler, &matches) != HS_SUCCESS)
+            throw std::runtime_error{"Hyperscan scan error"};
+
+        length += matches.length;
+        offset += size;
+    }
+
+    return length;
 }
 
-static void BM_AllLines_Hyperscan(benchmark::State& state, const char* pattern)
+// Reads the file in chunks of chunk_size bytes and feeds them into a Hyperscan stream.
+std::size_t scan_hyperscan_stream(const std::filesystem::path& filename, const std::size_t chunk_size, const hs_database_t* database, hs_scratch_t* scratch, std::vector<char>& chunk)
+{
+    std::ifstream in(filename, std::ios::binary);
+    hs_stream_t* open_stream;
+    LineMatches matches{nullptr, {}};
+    unsigned long long stream_offset = 0;
+
+    if (hs_open_stream(database, 0, &open_stream) != HS_SUCCESS)
+        throw std::runtime_error{"Hyperscan unable to open stream"};
+
+    // discards the stream without reporting further matches if the scan throws
+    const auto discard_stream = [](hs_stream_t* s) { hs_close_stream(s, nullptr, nullptr, nullptr); };
+    std::unique_ptr<hs_stream_t, decltype(discard_stream)> stream{open_stream, discard_stream};
+
+    chunk.resize(chunk_size);
+
+    while (in.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) || in.gcount() > 0) {
+        const auto size = static_cast<std::size_t>(in.gcount());
+
+        // only the last line break before this chunk can still be the start of a matching line
+        if (matches.newlines.size() > 1)
+            matches.newlines.erase(matches.newlines.begin(), matches.newlines.end() - 1);
+
+        for (const char* p = chunk.data(); (p = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(chunk.data() + size - p)))) != nullptr; ++p)
+            matches.newlines.push_back(stream_offset + static_cast<unsigned long long>(p - chunk.data()));
+
+        if (hs_scan_stream(stream.get(), chunk.data(), static_cast<unsigned int>(size), 0, scratch, stream_match_handler, &matches) != HS_SUCCESS)
+            throw std::runtime_error{"Hyperscan scan error"};
+
+        stream_offset += size;
+    }
+
+    if (hs_close_stream(stream.release(), scratch, stream_match_handler, &matches) != HS_SUCCESS)
+        throw std::runtime_error{"Hyperscan unable to close stream"};
+
+    return matches.length;
+}
+
+static void BM_Logfile_Hyperscan_Block(benchmark::State& state, const char* pattern)
 {
     std::size_t length = 0;
 
-    auto [database, scratch] = init_hyperscan(pattern);
+    const MappedFile file{logfile_path()};
+    auto [database, scratch] = init_hyperscan_multiline(pattern, HS_MODE_BLOCK);
 
     for (auto _ : state)
-        for (auto line : all_lines)
-            length += check_hyperscan(line, database, scratch);
+        length += scan_hyperscan_block(file.data(), database, scratch);
 
     hs_free_scratch(scratch);
     hs_free_database(database);
 
-    state.counters["length"] = length;
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(file.data().size()));
+    state.counters["length"] = static_cast<double>(length);
 }
 
-static void BM_Logfile_Hyperscan(benchmark::State& state, const char* pattern)
+static void BM_Logfile_Hyperscan_Stream(benchmark::State& state, const char* pattern)
 {
     std::size_t length = 0;
+    std::vector<char> chunk;
+
+    const std::filesystem::path filename = logfile_path();
 
-    auto lines = load_logfile();
-    auto [database, scratch] = init_hyperscan(pattern);
+    auto [database, scratch] = init_hyperscan_multiline(pattern, HS_MODE_STREAM);
 
     for (auto _ : state)
-        for (auto line : lines)
-            length += check_hyperscan(line, database, scratch);
+        length += scan_hyperscan_stream(filename, static_cast<std::size_t>(state.range(0)), database, scratch, chunk);
 
     hs_free_scratch(scratch);
     hs_free_database(database);
 
-    state.counters["length"] = length;
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(std::filesystem::file_size(filename)));
+    state.counters["length"] = static_cast<double>(length);
+}
+
+// Matches many patterns in one scan. Every pattern has its own ID, flags and an entry in the
+// dispatch table, which gets called with the pattern ID and the match offsets.
+class HyperscanMultiMatcher {
+public:
+    using Handler = std::function<void(unsigned int id, unsigned long long from, unsigned long long to)>;
+
+    HyperscanMultiMatcher(const std::vector<std::string>& patterns, const std::vector<unsigned int>& flags, std::vector<Handler> handlers)
+        : handlers_{std::move(handlers)}
+    {
+        if (patterns.size() != flags.size() || patterns.size() != handlers_.size())
+            throw std::runtime_error{"number of patterns, flags and handlers differ"};
+
+        std::vector<const char*> expressions;
+        std::vector<unsigned int> ids;
+
+        for (std::size_t i = 0; i < patterns.size(); ++i) {
+            expressions.push_back(patterns[i].c_str());
+            ids.push_back(static_cast<unsigned int>(i));
+        }
+
+        hs_compile_error_t* compile_err;
+
+        if (hs_compile_multi(expressions.data(), flags.data(), ids.data(), static_cast<unsigned int>(expressions.size()), HS_MODE_BLOCK, nullptr, &database_, &compile_err) != HS_SUCCESS) {
+            const std::string message = compile_err->message;
+            hs_free_compile_error(compile_err);
+            throw std::runtime_error{"Hyperscan unable to compile patterns: " + message};
+        }
+
+        if (hs_alloc_scratch(database_, &scratch_) != HS_SUCCESS) {
+            hs_free_database(database_);
+            throw std::runtime_error{"Hyperscan unable to allocate scratch space"};
+        }
+    }
+
+    HyperscanMultiMatcher(const HyperscanMultiMatcher&) = delete;
+    HyperscanMultiMatcher& operator=(const HyperscanMultiMatcher&) = delete;
+
+    ~HyperscanMultiMatcher()
+    {
+        hs_free_scratch(scratch_);
+        hs_free_database(database_);
+    }
+
+    void scan(const std::string_view line)
+    {
+        if (hs_scan(database_, line.data(), static_cast<unsigned int>(line.size()), 0, scratch_, dispatch, this) != HS_SUCCESS)
+            throw std::runtime_error{"Hyperscan scan error"};
+    }
+
+private:
+    std::vector<Handler> handlers_;
+    hs_database_t* database_;
+    hs_scratch_t* scratch_ = nullptr;
+
+    static int dispatch(unsigned int id, unsigned long long from, unsigned long long to, unsigned int, void* ctx)
+    {
+        static_cast<HyperscanMultiMatcher*>(ctx)->handlers_[id](id, from, to);
+        return 0;
+    }
+};
+
+// Same classification as BM_Logfile_MultiPattern, but with all patterns in one database.
+static void BM_Logfile_Hyperscan_Multi(benchmark::State& state)
+{
+    const CorpusLines corpus_lines = load_logfile_mapped();
+    const auto patterns = make_multi_patterns(static_cast<std::size_t>(state.range(0)));
+
+    std::vector<std::size_t> pattern_matches(patterns.size());
+    const HyperscanMultiMatcher::Handler count_match = [&](const unsigned int id, unsigned long long, unsigned long long) { ++pattern_matches[id]; };
+
+    HyperscanMultiMatcher matcher{patterns, std::vector<unsigned int>(patterns.size(), HS_FLAG_DOTALL | HS_FLAG_SINGLEMATCH), std::vector<HyperscanMultiMatcher::Handler>(patterns.size(), count_match)};
+
+    for (auto _ : state)
+        for (const auto& line : corpus_lines.lines())
+            matcher.scan(line);
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(corpus_lines.bytes()));
+
+    std::size_t matches = 0;
+
+    for (const std::size_t n : pattern_matches)
+        matches += n;
+
+    state.counters["matches"] = benchmark::Counter(static_cast<double>(matches), benchmark::Counter::kAvgIterations);
 }
 
-BENCHMARK_CAPTURE(BM_OneLine_Hyperscan, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_OneLine_Hyperscan, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_Hyperscan, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_AllLines_Hyperscan, 2, regex2)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_Hyperscan, 1, regex1)->Unit(benchmark::kMicrosecond);
-BENCHMARK_CAPTURE(BM_Logfile_Hyperscan, 2, regex2)->Unit(benchmark::kMicrosecond);
+// Checks line_local_pattern() against expected rewrites and compares which lines the original and
+// the rewritten pattern match. The lines contain no line breaks, so both have to match the same.
+static void BM_LineLocalPattern_Consistency(benchmark::State& state)
+{
+    const std::pair<const char*, const char*> rewrites[] = {
+        {"[^ ]+", "[^\\n ]+"},
+        {"[^]a]bcd", "[^]\\na]bcd"},
+        {"x[^]]+y", "x[^]\\n]+y"},
+        {"[]a]+b", "[]a]+b"},
+        {"[a[^b]c", "[a[^b]c"},
+        {"[^[:digit:]]z", "[^\\n[:digit:]]z"}};
+
+    std::vector<std::string> lines{all_lines};
+    lines.insert(lines.end(), {one_line, "xbcd", "a]bcd", "]bcd", "xa]y", "x]y", "xaay", "]]b", "ab", "[c", "^c", "az", "1z", "]z"});
+
+    std::size_t mismatches = 0;
+
+    for (auto _ : state) {
+        std::vector<std::string> patterns{regex1, regex2, regex3};
+
+        for (const auto& [pattern, expected] : rewrites) {
+            if (line_local_pattern(pattern) != expected)
+                ++mismatches;
+
+            patterns.push_back(pattern);
+        }
+
+        for (const auto& pattern : patterns) {
+            bool matched[2] = {false, false};
+            const HyperscanMultiMatcher::Handler set_matched = [&](const unsigned int id, unsigned long long, unsigned long long) { matched[id] = true; };
+
+            HyperscanMultiMatcher matcher{{pattern, line_local_pattern(pattern)}, {HS_FLAG_SINGLEMATCH, HS_FLAG_MULTILINE | HS_FLAG_SINGLEMATCH}, {set_matched, set_matched}};
+
+            for (const auto& line : lines) {
+                matched[0] = matched[1] = false;
+                matcher.scan(line);
+
+                if (matched[0] != matched[1])
+                    ++mismatches;
+            }
+        }
+    }
+
+    state.counters["mismatches"] = static_cast<double>(mismatches);
+
+    if (mismatches > 0)
+        state.SkipWithError("line_local_pattern() changes which lines match");
+}
+
+static const bool match_benchmarks_registered = register_match_benchmarks<HyperscanMatcher>({{"1", regex1}, {"2", regex2}});
+static const bool compile_benchmarks_registered = register_compile_benchmarks<HyperscanMatcher>();
+static const bool pattern_cache_benchmarks_registered = register_pattern_cache_benchmarks<HyperscanCacheEngine>();
+static const bool thread_local_benchmarks_registered = register_thread_local_benchmarks<ThreadLocalHyperscanMatcher>();
+static const bool synthetic_benchmarks_registered = register_synthetic_benchmarks<HyperscanMatcher>({"2", regex2});
+static const bool literal_filter_benchmarks_registered = register_match_benchmarks<LiteralFilter<HyperscanMatcher>>({{"1", regex1}, {"2", regex2}});
+static const bool load_benchmarks_registered = register_load_benchmarks<HyperscanMatcher>({"2", regex2});
+static const bool multi_pattern_benchmarks_registered = register_multi_pattern_benchmarks<HyperscanMatcher>();
+
+BENCHMARK_CAPTURE(BM_Logfile_Hyperscan_Block, 1, regex1)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Logfile_Hyperscan_Block, 2, regex2)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Logfile_Hyperscan_Stream, 1, regex1)->Arg(64 * 1024)->Arg(1024 * 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Logfile_Hyperscan_Stream, 2, regex2)->Arg(64 * 1024)->Arg(1024 * 1024)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_Logfile_Hyperscan_Multi)->Arg(1)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LineLocalPattern_Consistency)->Iterations(1);
 
 BENCHMARK_MAIN();
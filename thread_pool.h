@@ -0,0 +1,98 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs the same task on a fixed number of threads, the calling thread being one of them, and waits
+// until every thread has finished it. The worker threads are kept alive between tasks.
+class ThreadPool {
+public:
+    explicit ThreadPool(const int num_threads)
+    {
+        for (int index = 1; index < num_threads; ++index)
+            threads_.emplace_back(&ThreadPool::worker, this, index);
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+
+        start_.notify_all();
+
+        for (auto& thread : threads_)
+            thread.join();
+    }
+
+    int size() const { return static_cast<int>(threads_.size()) + 1; }
+
+    // Calls task(thread_index) once on every thread, thread_index is in [0, size()).
+    void run(const std::function<void(int)>& task)
+    {
+        if (!threads_.empty()) {
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                task_ = &task;
+                running_ = static_cast<int>(threads_.size());
+                ++generation_;
+            }
+
+            start_.notify_all();
+        }
+
+        task(0);
+
+        if (!threads_.empty()) {
+            std::unique_lock<std::mutex> lock{mutex_};
+            done_.wait(lock, [this] { return running_ == 0; });
+        }
+    }
+
+private:
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    const std::function<void(int)>* task_ = nullptr;
+    std::uint64_t generation_ = 0;
+    int running_ = 0;
+    bool stop_ = false;
+
+    void worker(const int index)
+    {
+        std::uint64_t seen_generation = 0;
+
+        while (true) {
+            const std::function<void(int)>* task;
+
+            {
+                std::unique_lock<std::mutex> lock{mutex_};
+                start_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+
+                if (stop_)
+                    return;
+
+                seen_generation = generation_;
+                task = task_;
+            }
+
+            (*task)(index);
+
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+
+                if (--running_ == 0)
+                    done_.notify_one();
+            }
+        }
+    }
+};